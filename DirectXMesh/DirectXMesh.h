@@ -107,6 +107,62 @@ namespace DirectX
         _In_ size_t cacheSize, _Out_ float& acmr, _Out_ float& atvr);
         // Compute the average cache miss ratio and average triangle vertex reuse for the post-transform vertex cache
 
+    enum VCACHE_MODEL : uint32_t
+    {
+        VCACHE_FIFO = 0,
+        // First-in first-out cache of CacheSize vertices
+
+        VCACHE_LRU = 1,
+        // Least-recently-used cache of CacheSize vertices
+
+        VCACHE_BATCH = 2,
+        // Primitive batches of up to CacheSize unique vertices and BatchPrims primitives, with vertex reuse only within a batch
+    };
+
+    struct VertexCacheModel
+    {
+        VCACHE_MODEL    Model;
+        uint32_t        CacheSize;
+        uint32_t        BatchPrims;     // VCACHE_BATCH only, 0 for no primitive limit
+    };
+
+    struct VertexCacheStats
+    {
+        float   ACMR;   // average cache miss ratio (vertices transformed per triangle)
+        float   ATVR;   // average transform to vertex ratio (vertices transformed per vertex)
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl ComputeVertexCacheMissRate(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nModels) const VertexCacheModel* models, _In_ size_t nModels,
+        _Out_writes_(nModels) VertexCacheStats* stats) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl ComputeVertexCacheMissRate(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nModels) const VertexCacheModel* models, _In_ size_t nModels,
+        _Out_writes_(nModels) VertexCacheStats* stats) noexcept;
+        // Evaluates several vertex cache models and sizes in a single pass over the index buffer
+
+    constexpr size_t VFETCH_DEFAULT_LINE_SIZE = 64u;
+    constexpr size_t VFETCH_DEFAULT_CACHE_SIZE = 16384u;
+
+    struct VertexFetchStats
+    {
+        size_t  BytesFetched;   // bytes read from memory in whole cache lines
+        float   Overfetch;      // bytes fetched / bytes of the distinct vertices referenced (1 = no overfetch)
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl ComputeVertexFetchStats(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _Out_writes_(nStreams) VertexFetchStats* stats,
+        _In_ size_t lineSize = VFETCH_DEFAULT_LINE_SIZE, _In_ size_t cacheSize = VFETCH_DEFAULT_CACHE_SIZE) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl ComputeVertexFetchStats(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _Out_writes_(nStreams) VertexFetchStats* stats,
+        _In_ size_t lineSize = VFETCH_DEFAULT_LINE_SIZE, _In_ size_t cacheSize = VFETCH_DEFAULT_CACHE_SIZE) noexcept;
+        // Simulates vertex fetch through a cache of cacheSize bytes in lineSize lines shared by all streams
+
     //---------------------------------------------------------------------------------
     // Vertex Buffer Reader/Writer
 
@@ -356,6 +412,9 @@ namespace DirectX
 
         VALIDATE_ASYMMETRIC_ADJ = 0x10,
         // Checks that neighbors are symmetric (requires adjacency)
+
+        VALIDATE_QUICK = 0x20,
+        // Stops at the first problem of each requested class, or at the first out-of-range value
     };
 
     DIRECTX_MESH_API HRESULT __cdecl Validate(
@@ -368,6 +427,41 @@ namespace DirectX
         _In_ VALIDATE_FLAGS flags, _In_opt_ std::wstring* msgs = nullptr);
         // Checks the mesh for common problems, return 'S_OK' if no problems were found
 
+    struct ValidateStats
+    {
+        size_t  InvalidIndices;     // faces with an index or neighbor value out of range
+        size_t  Unused;             // unused faces that still reference vertices or neighbors (VALIDATE_UNUSED)
+        size_t  Degenerate;         // degenerate faces (VALIDATE_DEGENERATE)
+        size_t  Backfacing;         // faces with a duplicate neighbor (VALIDATE_BACKFACING)
+        size_t  AsymmetricAdj;      // faces with a neighbor that doesn't reference back (VALIDATE_ASYMMETRIC_ADJ)
+        size_t  Bowties;            // vertices used by two separate fans of triangles (VALIDATE_BOWTIES)
+        size_t  FaceCount;          // number of offending face ids written to faces
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl Validate(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ VALIDATE_FLAGS flags, _Out_ ValidateStats& stats,
+        _Out_writes_opt_(maxFaces) uint32_t* faces = nullptr, _In_ size_t maxFaces = 0) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl Validate(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ VALIDATE_FLAGS flags, _Out_ ValidateStats& stats,
+        _Out_writes_opt_(maxFaces) uint32_t* faces = nullptr, _In_ size_t maxFaces = 0) noexcept;
+        // Counts problems per class without building messages, returning 'S_OK' if none were found
+        // Optionally lists up to maxFaces offending faces in face order, followed by a face for each bowtie
+        // Bowties are not checked if any index or neighbor value is out of range, or if neighbors are asymmetric
+
+    DIRECTX_MESH_API HRESULT __cdecl ValidateIB(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_ VALIDATE_FLAGS flags) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl ValidateIB(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_ VALIDATE_FLAGS flags) noexcept;
+        // Checks indices for out-of-range values without adjacency, returning 'S_OK' if no problems were found
+        // Also checks for degenerate (VALIDATE_DEGENERATE) and partially unused (VALIDATE_UNUSED) faces
+        // Stops at the first problem found; flags which require adjacency are ignored
+
     DIRECTX_MESH_API HRESULT __cdecl Clean(
         _Inout_updates_all_(nFaces * 3) uint16_t* indices, _In_ size_t nFaces,
         _In_ size_t nVerts, _Inout_updates_all_opt_(nFaces * 3) uint32_t* adjacency,
@@ -395,6 +489,37 @@ namespace DirectX
         _In_ std::function<bool __cdecl(uint32_t v0, uint32_t v1)> weldTest);
         // Welds vertices together based on a test function
 
+    struct WeldVertexData
+    {
+        const XMFLOAT3* Positions;          // required
+        size_t          PositionStride;     // bytes between vertices, 0 if tightly packed
+        const XMFLOAT3* Normals;            // optional
+        size_t          NormalStride;
+        const XMFLOAT2* TexCoords;          // optional
+        size_t          TexCoordStride;
+        const XMFLOAT4* Colors;             // optional
+        size_t          ColorStride;
+    };
+
+    struct WeldTolerances
+    {
+        float   Position;       // maximum distance between positions
+        float   NormalAngle;    // maximum angle between normals in radians
+        float   TexCoord;       // maximum distance between texture coordinates
+        float   Color;          // maximum difference of any color channel
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl WeldVertices(
+        _Inout_updates_all_(nFaces * 3) uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_ const WeldVertexData& vertices, _In_ const WeldTolerances& tolerances,
+        _Out_writes_opt_(nVerts) uint32_t* vertexRemap) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl WeldVertices(
+        _Inout_updates_all_(nFaces * 3) uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_ const WeldVertexData& vertices, _In_ const WeldTolerances& tolerances,
+        _Out_writes_opt_(nVerts) uint32_t* vertexRemap) noexcept;
+        // Welds vertices whose attributes are all within tolerance, finding candidates with a spatial hash of positions
+        // Each vertex is welded to the lowest numbered earlier vertex that was kept and matches it
+
     DIRECTX_MESH_API HRESULT __cdecl ConcatenateMesh(
         _In_ size_t nFaces,
         _In_ size_t nVerts,
@@ -404,6 +529,34 @@ namespace DirectX
         _Inout_ size_t& totalVerts) noexcept;
         // Merge meshes together
 
+    enum CONCAT_FLAGS : uint32_t
+    {
+        CONCAT_DEFAULT = 0,
+
+        CONCAT_WELD_IDENTICAL = 0x1,
+        // Welds vertices whose bytes are identical in every stream, including across mesh boundaries
+    };
+
+    struct ConcatenateMeshInput
+    {
+        const uint32_t*     Indices;        // FaceCount * 3 indices into this mesh's vertices
+        size_t              FaceCount;
+        const void* const*  VertexStreams;  // one vertex buffer per stream, laid out with the shared strides
+        size_t              VertexCount;
+        const uint32_t*     Attributes;     // FaceCount entries, required when merging attributes
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl ConcatenateMesh(
+        _In_reads_(nMeshes) const ConcatenateMeshInput* meshes, _In_ size_t nMeshes,
+        _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _Out_writes_(_Inexpressible_("sum of FaceCount * 3")) uint32_t* indices,
+        _In_reads_(nStreams) void* const* vbout,
+        _Out_writes_opt_(_Inexpressible_("sum of FaceCount")) uint32_t* attributes,
+        _Out_ size_t& totalFaces, _Out_ size_t& totalVerts,
+        _In_ CONCAT_FLAGS flags = CONCAT_DEFAULT) noexcept;
+        // Merges meshes into one index buffer, set of vertex streams, and attribute buffer in a single parallel pass
+        // Outputs are sized for the summed face and vertex counts; totalVerts is smaller when vertices are welded
+
     //---------------------------------------------------------------------------------
     // Mesh Optimization
 
@@ -445,7 +598,16 @@ namespace DirectX
         _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
         _Out_writes_(nFaces) uint32_t* faceRemap,
         _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeFacesTipsify(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeFacesTipsify(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
         // Reorders faces to increase hit rate of vertex caches
+        // Tipsify runs in linear time and does not require adjacency
 
     DIRECTX_MESH_API HRESULT __cdecl OptimizeFacesEx(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
@@ -471,8 +633,63 @@ namespace DirectX
         _In_reads_(nFaces) const uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap,
         _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeFacesTipsifyEx(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeFacesTipsifyEx(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
         // Attribute group version of OptimizeFaces
 
+    DIRECTX_MESH_API HRESULT __cdecl GenerateStrips(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        std::vector<uint16_t>& stripIndices,
+        _Out_opt_ std::vector<std::pair<size_t, size_t>>* stripSubsets = nullptr,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl GenerateStrips(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        std::vector<uint32_t>& stripIndices,
+        _Out_opt_ std::vector<std::pair<size_t, size_t>>* stripSubsets = nullptr,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+        // Builds a triangle strip index buffer with strips separated by the strip cut index (0xFFFF or 0xFFFFFFFF)
+        // Strips never cross attributes; stripSubsets receives the index offset,count for each attribute group
+        // vertexCache limits the strip length for cache reuse between adjacent strips, or OPTFACES_V_STRIPORDER for no limit
+
+    enum OPTOVERDRAW_FLAGS : uint32_t
+    {
+        OPTOVERDRAW_DEFAULT = 0,
+
+        OPTOVERDRAW_WIND_CW = 0x1,
+        // Vertices are clock-wise (defaults to CCW)
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeOverdraw(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ float threshold = 1.05f,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT,
+        _In_ OPTOVERDRAW_FLAGS flags = OPTOVERDRAW_DEFAULT) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeOverdraw(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ float threshold = 1.05f,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT,
+        _In_ OPTOVERDRAW_FLAGS flags = OPTOVERDRAW_DEFAULT) noexcept;
+        // Reorders clusters of faces to reduce overdraw; indices should already be optimized for the vertex cache
+        // threshold is the allowed ACMR increase for splitting clusters (i.e. 1.05 allows 5% more cache misses)
+
     DIRECTX_MESH_API HRESULT __cdecl OptimizeVertices(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
         _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr) noexcept;
@@ -481,6 +698,36 @@ namespace DirectX
         _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr) noexcept;
         // Reorders vertices in order of use
 
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeVerticesForFetch(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr,
+        _In_ size_t lineSize = VFETCH_DEFAULT_LINE_SIZE, _In_ size_t cacheSize = VFETCH_DEFAULT_CACHE_SIZE) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeVerticesForFetch(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr,
+        _In_ size_t lineSize = VFETCH_DEFAULT_LINE_SIZE, _In_ size_t cacheSize = VFETCH_DEFAULT_CACHE_SIZE) noexcept;
+        // Reorders vertices to reduce the bytes fetched from vertex streams with the given strides (see ComputeVertexFetchStats),
+        // packing vertices used close together into shared cache lines, or keeping first use or last use order if either fetches less
+
+    DIRECTX_MESH_API HRESULT __cdecl GenerateShadowIB(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nVerts) const uint32_t* pointRep,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces * 3) uint16_t* shadowIndices,
+        _Out_writes_(nVerts) uint32_t* shadowVertexRemap, _Out_opt_ size_t* trailingUnused = nullptr,
+        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl GenerateShadowIB(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nVerts) const uint32_t* pointRep,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces * 3) uint32_t* shadowIndices,
+        _Out_writes_(nVerts) uint32_t* shadowVertexRemap, _Out_opt_ size_t* trailingUnused = nullptr,
+        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+        // Generates a vertex cache optimized position-only index buffer where vertices sharing a point representative are welded
+        // Use CompactVB with shadowVertexRemap and trailingUnused to build the matching position stream
+
     //---------------------------------------------------------------------------------
     // Remap functions
 
@@ -500,6 +747,16 @@ namespace DirectX
         _In_reads_(nFaces) const uint32_t* faceRemap) noexcept;
         // Applies a face remap reordering to an index buffer
 
+    DIRECTX_MESH_API HRESULT __cdecl ReorderIB(
+        _Inout_updates_all_(nFaces * 3) uint16_t* ib, _In_ size_t nFaces,
+        _In_reads_(nFaces) const uint32_t* faceRemap,
+        _Inout_ std::vector<uint8_t>& workspace) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl ReorderIB(
+        _Inout_updates_all_(nFaces * 3) uint32_t* ib, _In_ size_t nFaces,
+        _In_reads_(nFaces) const uint32_t* faceRemap,
+        _Inout_ std::vector<uint8_t>& workspace) noexcept;
+        // In-place face remap using a reusable workspace, which allows a parallel copy instead of swapping
+
     DIRECTX_MESH_API HRESULT __cdecl ReorderIBAndAdjacency(
         _In_reads_(nFaces * 3) const uint16_t* ibin, _In_ size_t nFaces, _In_reads_(nFaces * 3) const uint32_t* adjin,
         _In_reads_(nFaces) const uint32_t* faceRemap,
@@ -516,6 +773,16 @@ namespace DirectX
         _In_reads_(nFaces) const uint32_t* faceRemap) noexcept;
         // Applies a face remap reordering to an index buffer and adjacency
 
+    DIRECTX_MESH_API HRESULT __cdecl ReorderIBAndAdjacency(
+        _Inout_updates_all_(nFaces * 3) uint16_t* ib, _In_ size_t nFaces, _Inout_updates_all_(nFaces * 3) uint32_t* adj,
+        _In_reads_(nFaces) const uint32_t* faceRemap,
+        _Inout_ std::vector<uint8_t>& workspace) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl ReorderIBAndAdjacency(
+        _Inout_updates_all_(nFaces * 3) uint32_t* ib, _In_ size_t nFaces, _Inout_updates_all_(nFaces * 3) uint32_t* adj,
+        _In_reads_(nFaces) const uint32_t* faceRemap,
+        _Inout_ std::vector<uint8_t>& workspace) noexcept;
+        // In-place face remap of an index buffer and adjacency using a reusable workspace
+
     DIRECTX_MESH_API HRESULT __cdecl FinalizeIB(
         _In_reads_(nFaces * 3) const uint16_t* ibin, _In_ size_t nFaces,
         _In_reads_(nVerts) const uint32_t* vertexRemap, _In_ size_t nVerts,
@@ -542,6 +809,18 @@ namespace DirectX
         _In_reads_(nVerts) const uint32_t* vertexRemap) noexcept;
         // Applies a vertex remap and/or a vertex duplication set to a vertex buffer
 
+    DIRECTX_MESH_API HRESULT __cdecl FinalizeVB(
+        _In_reads_(nStreams) const void* const* vbin, _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _In_ size_t nVerts,
+        _In_reads_opt_(nDupVerts) const uint32_t* dupVerts, _In_ size_t nDupVerts,
+        _In_reads_opt_(nVerts + nDupVerts) const uint32_t* vertexRemap,
+        _In_reads_(nStreams) void* const* vbout) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl FinalizeVB(
+        _In_reads_(nStreams) void* const* vbs, _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _In_ size_t nVerts,
+        _In_reads_(nVerts) const uint32_t* vertexRemap) noexcept;
+        // Applies the same vertex remap and/or vertex duplication set to several vertex streams at once
+
     DIRECTX_MESH_API HRESULT __cdecl FinalizeVBAndPointReps(
         _In_reads_bytes_(nVerts*stride) const void* vbin, _In_ size_t stride, _In_ size_t nVerts,
         _In_reads_(nVerts) const uint32_t* prin,
@@ -562,6 +841,61 @@ namespace DirectX
         _Out_writes_bytes_((nVerts - trailingUnused)*stride) void* vbout) noexcept;
         // Applies a vertex remap which contains a known number of unused entries at the end
 
+    DIRECTX_MESH_API HRESULT __cdecl GenerateVertexRemap(
+        _In_reads_(nStreams) const void* const* vbs, _In_reads_(nStreams) const size_t* strides, _In_ size_t nStreams,
+        _In_ size_t nVerts,
+        _Out_writes_(nVerts) uint32_t* indices,
+        _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr) noexcept;
+        // Indexes an unindexed vertex soup by welding vertices whose bytes are identical in every stream
+        // Use FinalizeVB or CompactVB with vertexRemap and trailingUnused to build the unique vertex streams
+
+    //---------------------------------------------------------------------------------
+    // 16-bit index buffer splitting
+
+    constexpr size_t SPLITIB16_MAX_VERTS = 65535u;
+
+    struct IndexBufferChunk
+    {
+        uint32_t Attribute;
+        uint32_t BaseVertex;
+        uint32_t VertexCount;
+        uint32_t StartIndex;
+        uint32_t IndexCount;
+    };
+
+    DIRECTX_MESH_API HRESULT __cdecl SplitIB16(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Inout_ std::vector<IndexBufferChunk>& chunks,
+        _Inout_ std::vector<uint16_t>& indices16,
+        _Inout_ std::vector<uint32_t>& dupVerts,
+        _Inout_ std::vector<uint32_t>& vertexRemap,
+        _In_ size_t maxVerts = SPLITIB16_MAX_VERTS);
+        // Partitions faces in their existing order into chunks of at most maxVerts unique vertices
+        // that never cross an attribute boundary. Each chunk is drawn with its BaseVertex and the
+        // 16-bit indices [StartIndex, StartIndex + IndexCount). Apply dupVerts and vertexRemap with
+        // FinalizeVB to build the matching vertex buffer.
+
+    //---------------------------------------------------------------------------------
+    // Index buffer compression
+
+    DIRECTX_MESH_API HRESULT __cdecl EncodeIB(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _Inout_ std::vector<uint8_t>& encoded);
+    DIRECTX_MESH_API HRESULT __cdecl EncodeIB(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _Inout_ std::vector<uint8_t>& encoded);
+        // Compresses a triangle list index buffer using edge and vertex FIFOs. Works best after
+        // OptimizeFaces and OptimizeVertices; triangles may be rotated but keep their winding.
+
+    DIRECTX_MESH_API HRESULT __cdecl DecodeIB(
+        _In_reads_bytes_(encodedSize) const uint8_t* encoded, _In_ size_t encodedSize,
+        _In_ size_t nFaces, _Out_writes_(nFaces * 3) uint16_t* indices) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl DecodeIB(
+        _In_reads_bytes_(encodedSize) const uint8_t* encoded, _In_ size_t encodedSize,
+        _In_ size_t nFaces, _Out_writes_(nFaces * 3) uint32_t* indices) noexcept;
+        // Decompresses an index buffer produced by EncodeIB
+
     //---------------------------------------------------------------------------------
     // Meshlet Generation
 
@@ -571,6 +905,8 @@ namespace DirectX
     constexpr size_t MESHLET_MINIMUM_SIZE = 32u;
     constexpr size_t MESHLET_MAXIMUM_SIZE = 256u;
 
+    constexpr size_t MESHLET_DEFAULT_GROUP_SIZE = 32u;
+
     enum MESHLET_FLAGS : uint32_t
     {
         MESHLET_DEFAULT = 0,
@@ -601,6 +937,17 @@ namespace DirectX
         float                               ApexOffset;     // apex = center - axis * offset
     };
 
+    struct MeshletStats
+    {
+        size_t  MaxVerts;
+        size_t  MaxPrims;
+        size_t  MeshletCount;
+        float   VertexDuplication;  // unique vertex references / distinct vertices referenced (1 = no duplication)
+        float   VertexFill;         // average VertCount / MaxVerts
+        float   PrimitiveFill;      // average PrimCount / MaxPrims
+        float   ConeCullRate;       // expected fraction of primitives rejected by the normal cone test over all view directions
+    };
+
     DIRECTX_MESH_API HRESULT __cdecl ComputeMeshlets(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
         _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
@@ -641,6 +988,32 @@ namespace DirectX
         _In_ size_t maxVerts = MESHLET_DEFAULT_MAX_VERTS, _In_ size_t maxPrims = MESHLET_DEFAULT_MAX_PRIMS);
         // Generates meshlets for a mesh with several face subsets
 
+    DIRECTX_MESH_API HRESULT __cdecl ComputeMeshletsBestSize(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nCandidates) const std::pair<size_t, size_t>* candidates, _In_ size_t nCandidates,
+        _Inout_ std::vector<Meshlet>& meshlets,
+        _Inout_ std::vector<uint8_t>& uniqueVertexIB,
+        _Inout_ std::vector<MeshletTriangle>& primitiveIndices,
+        _Out_opt_ MeshletStats* bestStats = nullptr,
+        _In_ std::function<float __cdecl(const MeshletStats& stats)> costFunc = nullptr,
+        _In_ MESHLET_FLAGS flags = MESHLET_DEFAULT);
+    DIRECTX_MESH_API HRESULT __cdecl ComputeMeshletsBestSize(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nCandidates) const std::pair<size_t, size_t>* candidates, _In_ size_t nCandidates,
+        _Inout_ std::vector<Meshlet>& meshlets,
+        _Inout_ std::vector<uint8_t>& uniqueVertexIB,
+        _Inout_ std::vector<MeshletTriangle>& primitiveIndices,
+        _Out_opt_ MeshletStats* bestStats = nullptr,
+        _In_ std::function<float __cdecl(const MeshletStats& stats)> costFunc = nullptr,
+        _In_ MESHLET_FLAGS flags = MESHLET_DEFAULT);
+        // Generates meshlets for each candidate (maxVerts, maxPrims) limit and keeps the lowest cost result
+        // If candidates is null, a default set of common hardware sizes is evaluated
+        // If costFunc is null, a weighted sum of duplication, primitive fill, and cone culling is used
+
     DIRECTX_MESH_API HRESULT __cdecl ComputeCullData(
         _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
         _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
@@ -657,6 +1030,52 @@ namespace DirectX
         _In_ MESHLET_FLAGS flags = MESHLET_DEFAULT) noexcept;
         // Computes culling data for each input meshlet
 
+    DIRECTX_MESH_API HRESULT __cdecl ComputeMeshletGroups(
+        _Inout_updates_all_(nMeshlets) Meshlet* meshlets,
+        _Inout_updates_all_(nMeshlets) CullData* cullData, _In_ size_t nMeshlets,
+        _Inout_ std::vector<CullData>& groupCullData,
+        _Out_writes_opt_(nMeshlets) uint32_t* meshletRemap = nullptr,
+        _In_ size_t groupSize = MESHLET_DEFAULT_GROUP_SIZE);
+        // Reorders meshlets into spatially coherent groups of groupSize and computes culling data for each group
+        // Call once per meshlet subset; meshletRemap receives the original index of each reordered meshlet
+
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeVerticesForMeshlets(
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _Inout_updates_all_(nVertIndices) uint16_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _In_ size_t nVerts,
+        _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeVerticesForMeshlets(
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _Inout_updates_all_(nVertIndices) uint32_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _In_ size_t nVerts,
+        _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr) noexcept;
+        // Reorders vertices in order of first use by the meshlets and rewrites the unique vertex indices to match
+
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeMeshletPrimitives(
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _Inout_updates_all_(nVertIndices) uint16_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _Inout_updates_all_(nPrimIndices) MeshletTriangle* primitiveIndices, _In_ size_t nPrimIndices) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl OptimizeMeshletPrimitives(
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _Inout_updates_all_(nVertIndices) uint32_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _Inout_updates_all_(nPrimIndices) MeshletTriangle* primitiveIndices, _In_ size_t nPrimIndices) noexcept;
+        // Reorders primitives within each meshlet into a vertex-sharing order and renumbers local vertices in order of first use
+
+    DIRECTX_MESH_API HRESULT __cdecl GenerateMeshletIB(
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _In_reads_(nVertIndices) const uint16_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices, _In_ size_t nPrimIndices,
+        _Out_writes_(nPrimIndices * 3) uint16_t* indices,
+        _Out_writes_opt_(nMeshlets) std::pair<size_t, size_t>* drawRanges = nullptr) noexcept;
+    DIRECTX_MESH_API HRESULT __cdecl GenerateMeshletIB(
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _In_reads_(nVertIndices) const uint32_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices, _In_ size_t nPrimIndices,
+        _Out_writes_(nPrimIndices * 3) uint32_t* indices,
+        _Out_writes_opt_(nMeshlets) std::pair<size_t, size_t>* drawRanges = nullptr) noexcept;
+        // Converts meshlets back into a triangle list index buffer in meshlet order for non-mesh shader pipelines
+        // drawRanges receives the index offset,count of each meshlet for per-meshlet culling with indirect draws
+
     //---------------------------------------------------------------------------------
 #ifdef __clang__
 #pragma clang diagnostic push
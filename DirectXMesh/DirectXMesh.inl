@@ -23,6 +23,8 @@
 DEFINE_ENUM_FLAG_OPERATORS(CNORM_FLAGS);
 DEFINE_ENUM_FLAG_OPERATORS(VALIDATE_FLAGS);
 DEFINE_ENUM_FLAG_OPERATORS(MESHLET_FLAGS);
+DEFINE_ENUM_FLAG_OPERATORS(OPTOVERDRAW_FLAGS);
+DEFINE_ENUM_FLAG_OPERATORS(CONCAT_FLAGS);
 
 #ifdef __clang__
 #pragma clang diagnostic pop
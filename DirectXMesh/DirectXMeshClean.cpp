@@ -15,6 +15,483 @@ using namespace DirectX;
 
 namespace
 {
+    constexpr size_t c_BlockSize = 4096;
+
+    //---------------------------------------------------------------------------------
+    // Open-addressing table mapping a (vertex, attribute) pair to the duplicate vertex
+    // created for it, stored as a single flat array of entries.
+    //---------------------------------------------------------------------------------
+    class vertex_attribute_table
+    {
+    public:
+        vertex_attribute_table() noexcept :
+            mMask(0),
+            mCount(0)
+        {}
+
+        HRESULT initialize(size_t capacity) noexcept
+        {
+            size_t size = 64;
+            while (size < capacity * 2)
+                size <<= 1;
+
+            return allocate(size);
+        }
+
+        uint32_t find(uint32_t vertex, uint32_t attribute) const noexcept
+        {
+            for (size_t slot = hash(vertex, attribute) & mMask;; slot = (slot + 1) & mMask)
+            {
+                const entry& e = mTable[slot];
+                if (e.value == UNUSED32)
+                    return UNUSED32;
+
+                if (e.vertex == vertex && e.attribute == attribute)
+                    return e.value;
+            }
+        }
+
+        HRESULT insert(uint32_t vertex, uint32_t attribute, uint32_t value) noexcept
+        {
+            assert(value != UNUSED32);
+
+            // Keep the load factor at or below one half
+            if ((mCount + 1) * 2 > (mMask + 1))
+            {
+                std::unique_ptr<entry[]> old(std::move(mTable));
+                const size_t oldSize = mMask + 1;
+
+                HRESULT hr = allocate(oldSize * 2);
+                if (FAILED(hr))
+                    return hr;
+
+                for (size_t j = 0; j < oldSize; ++j)
+                {
+                    if (old[j].value != UNUSED32)
+                    {
+                        place(old[j]);
+                    }
+                }
+            }
+
+            place({ vertex, attribute, value });
+            ++mCount;
+            return S_OK;
+        }
+
+    private:
+        struct entry
+        {
+            uint32_t vertex;
+            uint32_t attribute;
+            uint32_t value;
+        };
+
+        static size_t hash(uint32_t vertex, uint32_t attribute) noexcept
+        {
+            uint32_t h = vertex * 0x9E3779B1u;
+            h ^= attribute * 0x85EBCA77u;
+            h ^= h >> 15;
+            h *= 0xC2B2AE3Du;
+            h ^= h >> 13;
+            return h;
+        }
+
+        HRESULT allocate(size_t size) noexcept
+        {
+            mTable.reset(new (std::nothrow) entry[size]);
+            if (!mTable)
+                return E_OUTOFMEMORY;
+
+            memset(mTable.get(), 0xFF, sizeof(entry) * size);
+            mMask = size - 1;
+            return S_OK;
+        }
+
+        void place(const entry& e) noexcept
+        {
+            size_t slot = hash(e.vertex, e.attribute) & mMask;
+            while (mTable[slot].value != UNUSED32)
+            {
+                slot = (slot + 1) & mMask;
+            }
+            mTable[slot] = e;
+        }
+
+        std::unique_ptr<entry[]>    mTable;
+        size_t                      mMask;
+        size_t                      mCount;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Steps to the next corner around the same vertex, returning UNUSED32 at a boundary
+    // or if the neighboring face doesn't link back.
+    //---------------------------------------------------------------------------------
+    inline uint32_t NextCornerCW(_In_reads_(nFaces * 3) const uint32_t* adjacency, size_t nFaces, uint32_t corner) noexcept
+    {
+        const uint32_t face = corner / 3;
+        const uint32_t neighbor = adjacency[corner];
+        if (neighbor >= nFaces)
+            return UNUSED32;
+
+        for (uint32_t edge = 0; edge < 3; ++edge)
+        {
+            if (adjacency[neighbor * 3 + edge] == face)
+                return neighbor * 3 + ((edge + 1) % 3);
+        }
+
+        return UNUSED32;
+    }
+
+    inline uint32_t NextCornerCCW(_In_reads_(nFaces * 3) const uint32_t* adjacency, size_t nFaces, uint32_t corner) noexcept
+    {
+        const uint32_t face = corner / 3;
+        const uint32_t neighbor = adjacency[face * 3 + ((corner % 3) + 2) % 3];
+        if (neighbor >= nFaces)
+            return UNUSED32;
+
+        for (uint32_t edge = 0; edge < 3; ++edge)
+        {
+            if (adjacency[neighbor * 3 + edge] == face)
+                return neighbor * 3 + edge;
+        }
+
+        return UNUSED32;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Splits bowties with the vertex fans processed in parallel. Each fan is handled from
+    // its lowest corner, which is where the serial scan would start it, and duplicates are
+    // numbered in that same order so the results are identical. Returns S_FALSE before
+    // touching dupVerts or indicesNew if the adjacency doesn't partition the corners into
+    // simple fans, in which case the caller falls back to the serial scan.
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT BreakBowtiesParallel(
+        _In_reads_(nFaces * 3) const index_t* indices,
+        size_t nFaces, size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _Out_writes_(nFaces * 3) bool* fanStart,
+        _Out_writes_(nVerts) uint32_t* ids,
+        _Inout_updates_all_(nFaces * 3) index_t* indicesNew,
+        _Inout_ std::vector<uint32_t>& dupVerts)
+    {
+        const size_t nCorners = nFaces * 3;
+        const int count = static_cast<int>((nFaces + c_BlockSize - 1) / c_BlockSize);
+
+        std::unique_ptr<uint32_t[]> links(new (std::nothrow) uint32_t[nCorners * 3]);
+        std::unique_ptr<size_t[]> blockCounts(new (std::nothrow) size_t[size_t(count) * 2]);
+        std::unique_ptr<bool[]> blockFailed(new (std::nothrow) bool[size_t(count)]);
+        if (!links || !blockCounts || !blockFailed)
+            return E_OUTOFMEMORY;
+
+        uint32_t* nextCW = links.get();
+        uint32_t* nextCCW = nextCW + nCorners;
+        uint32_t* owner = nextCCW + nCorners;
+        size_t* visitBase = blockCounts.get();
+        size_t* dupBase = visitBase + count;
+
+        auto validFace = [&](size_t face) noexcept -> bool
+            {
+                const index_t i0 = indices[face * 3];
+                const index_t i1 = indices[face * 3 + 1];
+                const index_t i2 = indices[face * 3 + 2];
+
+                return (i0 != index_t(-1) && i1 != index_t(-1) && i2 != index_t(-1)
+                    && i0 != i1 && i0 != i2 && i1 != i2);
+            };
+
+        // Link each corner to its neighbors around the vertex, which must agree in both directions
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces);
+
+            bool failed = false;
+            for (size_t face = start; face < end; ++face)
+            {
+                const bool valid = validFace(face);
+
+                for (uint32_t point = 0; point < 3; ++point)
+                {
+                    const auto corner = static_cast<uint32_t>(face * 3 + point);
+
+                    uint32_t cw = UNUSED32;
+                    uint32_t ccw = UNUSED32;
+                    if (valid)
+                    {
+                        if (adjacency[corner] != UNUSED32)
+                        {
+                            cw = NextCornerCW(adjacency, nFaces, corner);
+                            if (cw == UNUSED32
+                                || !validFace(cw / 3)
+                                || NextCornerCCW(adjacency, nFaces, cw) != corner)
+                                failed = true;
+                        }
+
+                        if (adjacency[face * 3 + ((point + 2) % 3)] != UNUSED32)
+                        {
+                            ccw = NextCornerCCW(adjacency, nFaces, corner);
+                            if (ccw == UNUSED32
+                                || !validFace(ccw / 3)
+                                || NextCornerCW(adjacency, nFaces, ccw) != corner)
+                                failed = true;
+                        }
+                    }
+
+                    nextCW[corner] = cw;
+                    nextCCW[corner] = ccw;
+                }
+            }
+
+            blockFailed[block] = failed;
+        }
+
+        for (int block = 0; block < count; ++block)
+        {
+            if (blockFailed[block])
+                return S_FALSE;
+        }
+
+        // Fans are now simple paths or loops, each started from its lowest corner by the serial scan
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces);
+
+            for (size_t face = start; face < end; ++face)
+            {
+                const bool valid = validFace(face);
+
+                for (uint32_t point = 0; point < 3; ++point)
+                {
+                    const auto corner = static_cast<uint32_t>(face * 3 + point);
+
+                    // Walk both ways so a lower corner nearby is found quickly
+                    bool lowest = valid;
+                    uint32_t cw = corner;
+                    uint32_t ccw = corner;
+                    while (lowest && (cw != UNUSED32 || ccw != UNUSED32))
+                    {
+                        if (cw != UNUSED32)
+                        {
+                            cw = nextCW[cw];
+                            if (cw == corner)
+                                break;
+
+                            if (cw < corner)
+                                lowest = false;
+                        }
+
+                        if (ccw != UNUSED32)
+                        {
+                            ccw = nextCCW[ccw];
+                            if (ccw == corner)
+                                break;
+
+                            if (ccw < corner)
+                                lowest = false;
+                        }
+                    }
+
+                    fanStart[corner] = lowest;
+                }
+            }
+        }
+
+        // Label each corner with its fan, which is walked clockwise from its counterclockwise end
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces);
+
+            bool failed = false;
+            size_t visits = 0;
+            for (auto corner = static_cast<uint32_t>(start * 3); corner < end * 3; ++corner)
+            {
+                if (!fanStart[corner])
+                    continue;
+
+                // A closed fan is walked from the fan start itself, as the serial orbit does
+                uint32_t first = corner;
+                for (uint32_t k = nextCCW[corner]; k != UNUSED32; k = nextCCW[k])
+                {
+                    if (k == corner)
+                    {
+                        first = corner;
+                        break;
+                    }
+
+                    first = k;
+                }
+
+                // The serial scan stops at a face it started in, so a fan may not pass through one twice
+                for (uint32_t k = first;;)
+                {
+                    if ((k != first && (k / 3) == (first / 3))
+                        || (k != corner && (k / 3) == (corner / 3)))
+                        failed = true;
+
+                    owner[k] = corner;
+                    ++visits;
+
+                    k = nextCW[k];
+                    if (k == UNUSED32 || k == first)
+                        break;
+                }
+
+                // The fan start only needs to find its first corner from here on
+                nextCCW[corner] = first;
+            }
+
+            visitBase[block] = visits;
+            blockFailed[block] = failed;
+        }
+
+        size_t totalVisits = 0;
+        for (int block = 0; block < count; ++block)
+        {
+            if (blockFailed[block])
+                return S_FALSE;
+
+            const size_t visits = visitBase[block];
+            visitBase[block] = totalVisits;
+            totalVisits += visits;
+        }
+
+        // Each vertex is kept by the first fan to use it
+        memset(ids, 0xFF, sizeof(uint32_t) * nVerts);
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            if (!validFace(face))
+                continue;
+
+            for (size_t point = 0; point < 3; ++point)
+            {
+                const uint32_t k = owner[face * 3 + point];
+                assert(k != UNUSED32);
+
+                const index_t j = indices[face * 3 + point];
+                ids[j] = std::min(ids[j], k / 3);
+            }
+        }
+
+        // Duplicates are written to a slot range per block and then packed, so they are numbered in scan order
+        dupVerts.resize(totalVisits);
+        uint32_t* slots = dupVerts.data();
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces);
+
+            size_t dups = 0;
+            for (auto corner = static_cast<uint32_t>(start * 3); corner < end * 3; ++corner)
+            {
+                if (!fanStart[corner])
+                    continue;
+
+                const uint32_t face = corner / 3;
+                const uint32_t first = nextCCW[corner];
+
+                index_t replaceVertex = index_t(-1);
+                uint32_t replaceSlot = UNUSED32;
+
+                for (uint32_t k = first;;)
+                {
+                    const index_t j = indices[k];
+
+                    if (j == replaceVertex)
+                    {
+                        owner[k] = replaceSlot;
+                    }
+                    else if (ids[j] != face)
+                    {
+                        // We found a bowtie, duplicate a vert
+                        replaceVertex = j;
+                        replaceSlot = static_cast<uint32_t>(visitBase[block] + dups);
+                        slots[replaceSlot] = j;
+                        owner[k] = replaceSlot;
+                        ++dups;
+                    }
+                    else
+                    {
+                        owner[k] = UNUSED32;
+                    }
+
+                    k = nextCW[k];
+                    if (k == UNUSED32 || k == first)
+                        break;
+                }
+            }
+
+            dupBase[block] = dups;
+        }
+
+        size_t totalDups = 0;
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t dups = dupBase[block];
+            dupBase[block] = totalDups;
+
+            if (dups > 0 && totalDups != visitBase[block])
+            {
+                memmove(slots + totalDups, slots + visitBase[block], sizeof(uint32_t) * dups);
+            }
+
+            totalDups += dups;
+        }
+
+        dupVerts.resize(totalDups);
+
+        if ((uint64_t(nVerts) + uint64_t(totalDups)) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces);
+
+            for (size_t face = start; face < end; ++face)
+            {
+                if (!validFace(face))
+                    continue;
+
+                for (size_t point = 0; point < 3; ++point)
+                {
+                    const uint32_t slot = owner[face * 3 + point];
+                    if (slot == UNUSED32)
+                        continue;
+
+                    // Find the block whose slot range holds this duplicate
+                    const size_t* it = std::upper_bound(visitBase, visitBase + count, size_t(slot)) - 1;
+                    const size_t n = size_t(it - visitBase);
+
+                    indicesNew[face * 3 + point] = index_t(nVerts + dupBase[n] + slot - visitBase[n]);
+                }
+            }
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
     template<class index_t>
     HRESULT CleanImpl(
         _Inout_updates_all_(nFaces * 3) index_t* indices,
@@ -208,97 +685,115 @@ namespace
         // BOWTIES cleanup
         if (adjacency && breakBowties)
         {
-            memset(faceSeen, 0, sizeof(bool) * nFaces * 3);
-            memset(ids, 0xFF, sizeof(uint32_t) * nVerts);
-
-            orbit_iterator<index_t> ovi(adjacency, indices, nFaces);
-
-            for (uint32_t face = 0; face < nFaces; ++face)
+            HRESULT hr = S_FALSE;
+        #ifdef _OPENMP
+            if (nFaces > c_BlockSize)
             {
-                index_t i0 = indices[face * 3];
-                index_t i1 = indices[face * 3 + 1];
-                index_t i2 = indices[face * 3 + 2];
+                hr = BreakBowtiesParallel(indices, nFaces, nVerts, adjacency, faceSeen, ids, indicesNew, dupVerts);
+                if (FAILED(hr))
+                    return hr;
+            }
+        #endif
 
-                if (i0 == index_t(-1)
-                    || i1 == index_t(-1)
-                    || i2 == index_t(-1))
-                {
-                    // ignore unused faces
-                    faceSeen[face * 3] = true;
-                    faceSeen[face * 3 + 1] = true;
-                    faceSeen[face * 3 + 2] = true;
-                    continue;
-                }
+            if (hr == S_OK)
+            {
+                curNewVert += dupVerts.size();
+            }
+            else
+            {
+                // Small meshes, builds without OpenMP, and adjacency that doesn't form simple fans use a serial scan
+                memset(faceSeen, 0, sizeof(bool) * nFaces * 3);
+                memset(ids, 0xFF, sizeof(uint32_t) * nVerts);
 
-                assert(i0 < nVerts);
-                assert(i1 < nVerts);
-                assert(i2 < nVerts);
+                orbit_iterator<index_t> ovi(adjacency, indices, nFaces);
 
-                if (i0 == i1
-                    || i0 == i2
-                    || i1 == i2)
+                for (uint32_t face = 0; face < nFaces; ++face)
                 {
-                    // ignore degenerate faces
-                    faceSeen[face * 3] = true;
-                    faceSeen[face * 3 + 1] = true;
-                    faceSeen[face * 3 + 2] = true;
-                    continue;
-                }
+                    index_t i0 = indices[face * 3];
+                    index_t i1 = indices[face * 3 + 1];
+                    index_t i2 = indices[face * 3 + 2];
 
-                for (uint32_t point = 0; point < 3; ++point)
-                {
-                    if (faceSeen[face * 3 + point])
+                    if (i0 == index_t(-1)
+                        || i1 == index_t(-1)
+                        || i2 == index_t(-1))
+                    {
+                        // ignore unused faces
+                        faceSeen[face * 3] = true;
+                        faceSeen[face * 3 + 1] = true;
+                        faceSeen[face * 3 + 2] = true;
                         continue;
+                    }
 
-                    faceSeen[face * 3 + point] = true;
+                    assert(i0 < nVerts);
+                    assert(i1 < nVerts);
+                    assert(i2 < nVerts);
 
-                    index_t i = indices[face * 3 + point];
-                    if (i == index_t(-1))
+                    if (i0 == i1
+                        || i0 == i2
+                        || i1 == i2)
+                    {
+                        // ignore degenerate faces
+                        faceSeen[face * 3] = true;
+                        faceSeen[face * 3 + 1] = true;
+                        faceSeen[face * 3 + 2] = true;
                         continue;
+                    }
+
+                    for (uint32_t point = 0; point < 3; ++point)
+                    {
+                        if (faceSeen[face * 3 + point])
+                            continue;
 
-                    assert(i < nVerts);
+                        faceSeen[face * 3 + point] = true;
 
-                    ovi.initialize(face, i, orbit_iterator<index_t>::ALL);
-                    ovi.moveToCCW();
+                        index_t i = indices[face * 3 + point];
+                        if (i == index_t(-1))
+                            continue;
 
-                    index_t replaceVertex = index_t(-1);
-                    index_t replaceValue = index_t(-1);
+                        assert(i < nVerts);
 
-                    while (!ovi.done())
-                    {
-                        uint32_t curFace = ovi.nextFace();
-                        if (curFace >= nFaces)
-                            return E_FAIL;
+                        ovi.initialize(face, i, orbit_iterator<index_t>::ALL);
+                        ovi.moveToCCW();
 
-                        uint32_t curPoint = ovi.getpoint();
-                        if (curPoint > 2)
-                            return E_FAIL;
+                        index_t replaceVertex = index_t(-1);
+                        index_t replaceValue = index_t(-1);
 
-                        faceSeen[curFace * 3 + curPoint] = true;
+                        while (!ovi.done())
+                        {
+                            uint32_t curFace = ovi.nextFace();
+                            if (curFace >= nFaces)
+                                return E_FAIL;
 
-                        index_t j = indices[curFace * 3 + curPoint];
-                        if (j == index_t(-1))
-                            continue;
+                            uint32_t curPoint = ovi.getpoint();
+                            if (curPoint > 2)
+                                return E_FAIL;
 
-                        assert(j < nVerts);
+                            faceSeen[curFace * 3 + curPoint] = true;
 
-                        if (j == replaceVertex)
-                        {
-                            indicesNew[curFace * 3 + curPoint] = replaceValue;
-                        }
-                        else if (ids[j] == UNUSED32)
-                        {
-                            ids[j] = face;
-                        }
-                        else if (ids[j] != face)
-                        {
-                            // We found a bowtie, duplicate a vert
-                            replaceVertex = j;
-                            replaceValue = index_t(curNewVert);
-                            indicesNew[curFace * 3 + curPoint] = replaceValue;
-                            ++curNewVert;
+                            index_t j = indices[curFace * 3 + curPoint];
+                            if (j == index_t(-1))
+                                continue;
+
+                            assert(j < nVerts);
+
+                            if (j == replaceVertex)
+                            {
+                                indicesNew[curFace * 3 + curPoint] = replaceValue;
+                            }
+                            else if (ids[j] == UNUSED32)
+                            {
+                                ids[j] = face;
+                            }
+                            else if (ids[j] != face)
+                            {
+                                // We found a bowtie, duplicate a vert
+                                replaceVertex = j;
+                                replaceValue = index_t(curNewVert);
+                                indicesNew[curFace * 3 + curPoint] = replaceValue;
+                                ++curNewVert;
 
-                            dupVerts.push_back(j);
+                                dupVerts.push_back(j);
+                            }
                         }
                     }
                 }
@@ -312,14 +807,13 @@ namespace
         {
             memset(ids, 0xFF, sizeof(uint32_t) * nVerts);
 
-            std::vector<uint32_t> dupAttr;
-            dupAttr.reserve(dupVerts.size());
-            for (size_t j = 0; j < dupVerts.size(); ++j)
-            {
-                dupAttr.push_back(UNUSED32);
-            }
+            std::vector<uint32_t> dupAttr(dupVerts.size(), UNUSED32);
 
-            std::unordered_multimap<uint32_t, size_t> dups;
+            // Each split vertex is found by its (vertex, attribute) pair
+            vertex_attribute_table dups;
+            HRESULT hr = dups.initialize(std::max<size_t>(dupVerts.size(), nVerts / 16));
+            if (FAILED(hr))
+                return hr;
 
             for (size_t face = 0; face < nFaces; ++face)
             {
@@ -327,7 +821,11 @@ namespace
 
                 for (size_t point = 0; point < 3; ++point)
                 {
-                    uint32_t j = indicesNew[face * 3 + point];
+                    const index_t i = indicesNew[face * 3 + point];
+                    if (i == index_t(-1))
+                        continue;
+
+                    uint32_t j = i;
 
                     const uint32_t k = (j >= nVerts) ? dupAttr[j - nVerts] : ids[j];
 
@@ -341,23 +839,20 @@ namespace
                     else if (k != a)
                     {
                         // Look for a dup with the correct attribute
-                        auto range = dups.equal_range(j);
-                        auto it = range.first;
-                        for (; it != range.second; ++it)
+                        const uint32_t m = dups.find(j, a);
+                        if (m != UNUSED32)
                         {
-                            const uint32_t m = (it->second >= nVerts) ? dupAttr[it->second - nVerts] : ids[it->second];
-                            if (m == a)
-                            {
-                                indicesNew[face * 3 + point] = index_t(it->second);
-                                break;
-                            }
+                            indicesNew[face * 3 + point] = index_t(m);
                         }
-
-                        if (it == range.second)
+                        else
                         {
                             // Duplicate the vert
-                            auto dv = std::pair<uint32_t, size_t>(j, curNewVert);
-                            dups.insert(dv);
+                            if (curNewVert >= UINT32_MAX)
+                                return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+                            hr = dups.insert(j, a, static_cast<uint32_t>(curNewVert));
+                            if (FAILED(hr))
+                                return hr;
 
                             indicesNew[face * 3 + point] = index_t(curNewVert);
                             ++curNewVert;
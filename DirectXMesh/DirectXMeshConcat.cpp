@@ -13,6 +13,22 @@
 
 using namespace DirectX;
 
+namespace
+{
+    constexpr size_t c_MaxStride = 2048;
+
+    // Number of faces and vertices of a mesh each thread copies at a time
+    constexpr size_t c_BlockSize = 4096;
+
+    // One block of faces and vertices from a mesh, and whether its indices were all in range
+    struct concat_chunk
+    {
+        size_t mesh;
+        size_t block;
+        bool valid;
+    };
+}
+
 //=====================================================================================
 // Entry-points
 //=====================================================================================
@@ -58,3 +74,242 @@ HRESULT __cdecl DirectX::ConcatenateMesh(
 
     return S_OK;
 }
+
+
+
+//-------------------------------------------------------------------------------------
+// Merges several meshes into one set of buffers
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT __cdecl DirectX::ConcatenateMesh(
+    const ConcatenateMeshInput* meshes,
+    size_t nMeshes,
+    const size_t* strides,
+    size_t nStreams,
+    uint32_t* indices,
+    void* const* vbout,
+    uint32_t* attributes,
+    size_t& totalFaces,
+    size_t& totalVerts,
+    CONCAT_FLAGS flags) noexcept
+{
+    totalFaces = totalVerts = 0;
+
+    if (!meshes || !nMeshes || !strides || !nStreams || !indices || !vbout)
+        return E_INVALIDARG;
+
+    for (size_t s = 0; s < nStreams; ++s)
+    {
+        if (!vbout[s] || !strides[s] || strides[s] > c_MaxStride)
+            return E_INVALIDARG;
+    }
+
+    uint64_t faceCount = 0;
+    uint64_t vertCount = 0;
+    size_t nChunks = 0;
+    for (size_t m = 0; m < nMeshes; ++m)
+    {
+        const ConcatenateMeshInput& mesh = meshes[m];
+        if (!mesh.Indices || !mesh.FaceCount || !mesh.VertexStreams || !mesh.VertexCount)
+            return E_INVALIDARG;
+
+        if (attributes && !mesh.Attributes)
+            return E_INVALIDARG;
+
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            if (!mesh.VertexStreams[s])
+                return E_INVALIDARG;
+        }
+
+        faceCount += mesh.FaceCount;
+        vertCount += mesh.VertexCount;
+        if ((faceCount * 3) >= UINT32_MAX || vertCount >= UINT32_MAX)
+            return E_FAIL;
+
+        const size_t blocks = (std::max(mesh.FaceCount, mesh.VertexCount) + c_BlockSize - 1) / c_BlockSize;
+        nChunks += blocks;
+    }
+
+    if (nChunks >= INT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    std::unique_ptr<size_t[]> bases(new (std::nothrow) size_t[nMeshes * 2]);
+    std::unique_ptr<concat_chunk[]> chunks(new (std::nothrow) concat_chunk[nChunks]);
+    if (!bases || !chunks)
+        return E_OUTOFMEMORY;
+
+    // Each mesh starts where the previous one ended, and is split into blocks so one large mesh
+    // doesn't serialize the copy
+    size_t* faceBase = bases.get();
+    size_t* vertBase = faceBase + nMeshes;
+    {
+        size_t nFaces = 0;
+        size_t nVerts = 0;
+        size_t chunk = 0;
+        for (size_t m = 0; m < nMeshes; ++m)
+        {
+            faceBase[m] = nFaces;
+            vertBase[m] = nVerts;
+            nFaces += meshes[m].FaceCount;
+            nVerts += meshes[m].VertexCount;
+
+            const size_t blocks = (std::max(meshes[m].FaceCount, meshes[m].VertexCount) + c_BlockSize - 1) / c_BlockSize;
+            for (size_t block = 0; block < blocks; ++block, ++chunk)
+            {
+                chunks[chunk] = { m, block, true };
+            }
+        }
+    }
+
+    const int count = static_cast<int>(nChunks);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+    for (int j = 0; j < count; ++j)
+    {
+        concat_chunk& chunk = chunks[size_t(j)];
+        const ConcatenateMeshInput& mesh = meshes[chunk.mesh];
+        const size_t start = chunk.block * c_BlockSize;
+
+        // Faces with rebased indices, keeping unused entries
+        if (start < mesh.FaceCount)
+        {
+            const size_t end = std::min(start + c_BlockSize, mesh.FaceCount);
+            const auto base = static_cast<uint32_t>(vertBase[chunk.mesh]);
+            const uint32_t* src = mesh.Indices + start * 3;
+            uint32_t* dest = indices + (faceBase[chunk.mesh] + start) * 3;
+
+            bool valid = true;
+            for (size_t i = 0; i < (end - start) * 3; ++i)
+            {
+                const uint32_t v = src[i];
+                valid &= (v < mesh.VertexCount) || (v == UNUSED32);
+                dest[i] = (v == UNUSED32) ? UNUSED32 : (base + v);
+            }
+            chunk.valid = valid;
+
+            if (attributes)
+            {
+                memcpy(attributes + faceBase[chunk.mesh] + start, mesh.Attributes + start, sizeof(uint32_t) * (end - start));
+            }
+        }
+
+        if (start < mesh.VertexCount)
+        {
+            const size_t end = std::min(start + c_BlockSize, mesh.VertexCount);
+            for (size_t s = 0; s < nStreams; ++s)
+            {
+                const size_t stride = strides[s];
+                memcpy(static_cast<uint8_t*>(vbout[s]) + (vertBase[chunk.mesh] + start) * stride,
+                    static_cast<const uint8_t*>(mesh.VertexStreams[s]) + start * stride,
+                    (end - start) * stride);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < nChunks; ++j)
+    {
+        if (!chunks[j].valid)
+            return E_UNEXPECTED;
+    }
+
+    const auto nFaces = static_cast<size_t>(faceCount);
+    auto nVerts = static_cast<size_t>(vertCount);
+
+    if (flags & CONCAT_WELD_IDENTICAL)
+    {
+        std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nVerts * 2]);
+        std::unique_ptr<const void*[]> vbs(new (std::nothrow) const void*[nStreams]);
+        if (!temp || !vbs)
+            return E_OUTOFMEMORY;
+
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            vbs[s] = vbout[s];
+        }
+
+        uint32_t* ids = temp.get();
+        uint32_t* vertexRemap = ids + nVerts;
+
+        size_t trailingUnused = 0;
+        HRESULT hr = GenerateVertexRemap(vbs.get(), strides, nStreams, nVerts, ids, vertexRemap, &trailingUnused);
+        if (FAILED(hr))
+            return hr;
+
+        if (trailingUnused > 0)
+        {
+            const int faceBlocks = static_cast<int>((nFaces * 3 + c_BlockSize - 1) / c_BlockSize);
+
+        #ifdef _OPENMP
+        #pragma omp parallel for if (faceBlocks > 1)
+        #endif
+            for (int block = 0; block < faceBlocks; ++block)
+            {
+                const size_t start = size_t(block) * c_BlockSize;
+                const size_t end = std::min(start + c_BlockSize, nFaces * 3);
+                for (size_t i = start; i < end; ++i)
+                {
+                    const uint32_t v = indices[i];
+                    if (v != UNUSED32)
+                    {
+                        indices[i] = ids[v];
+                    }
+                }
+            }
+
+            // Unique vertices are gathered into scratch streams, then copied back block by
+            // block, so both passes run in parallel over vertices
+            uint64_t scratchSize = 0;
+            for (size_t s = 0; s < nStreams; ++s)
+            {
+                scratchSize += uint64_t(nVerts) * strides[s];
+            }
+
+            if (scratchSize >= SIZE_MAX)
+                return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+            std::unique_ptr<uint8_t[]> scratch(new (std::nothrow) uint8_t[static_cast<size_t>(scratchSize)]);
+            std::unique_ptr<void*[]> scratchStreams(new (std::nothrow) void*[nStreams]);
+            if (!scratch || !scratchStreams)
+                return E_OUTOFMEMORY;
+
+            size_t offset = 0;
+            for (size_t s = 0; s < nStreams; ++s)
+            {
+                scratchStreams[s] = scratch.get() + offset;
+                offset += nVerts * strides[s];
+            }
+
+            hr = FinalizeVB(vbs.get(), strides, nStreams, nVerts, nullptr, 0, vertexRemap, scratchStreams.get());
+            if (FAILED(hr))
+                return hr;
+
+            nVerts -= trailingUnused;
+
+            const int vertBlocks = static_cast<int>((nVerts + c_BlockSize - 1) / c_BlockSize);
+
+        #ifdef _OPENMP
+        #pragma omp parallel for if (vertBlocks > 1)
+        #endif
+            for (int block = 0; block < vertBlocks; ++block)
+            {
+                const size_t start = size_t(block) * c_BlockSize;
+                const size_t end = std::min(start + c_BlockSize, nVerts);
+                for (size_t s = 0; s < nStreams; ++s)
+                {
+                    const size_t stride = strides[s];
+                    memcpy(static_cast<uint8_t*>(vbout[s]) + start * stride,
+                        static_cast<const uint8_t*>(scratchStreams[s]) + start * stride,
+                        (end - start) * stride);
+                }
+            }
+        }
+    }
+
+    totalFaces = nFaces;
+    totalVerts = nVerts;
+
+    return S_OK;
+}
@@ -0,0 +1,495 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshIBCodec.cpp
+//
+// DirectX Mesh Geometry Library - Index buffer compression
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// https://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+//
+// The stream is a header byte followed by three sections:
+//
+// - One code byte per triangle. A triangle which shares an edge with a recent triangle
+//   has the edge FIFO entry (0-14) in the high nibble and the code for the third vertex
+//   in the low nibble. Otherwise the high nibble is 0xF and the low nibble codes the
+//   first vertex.
+// - One byte for each triangle with no shared edge, holding the codes for its remaining
+//   two vertices.
+// - The explicit vertex indices, each a zigzag varint delta from the last explicit index.
+//
+// Vertex codes are 0 for the next never-seen index, 1-14 for a vertex FIFO entry, or 15
+// for an explicit index. Only explicit indices are variable length, and they live in
+// their own section, so the decoder walks the code bytes at a fixed stride.
+//
+
+namespace
+{
+    constexpr uint8_t IBCODEC_HEADER = 0xE2;
+
+    constexpr uint32_t CODE_NEXT = 0;
+    constexpr uint32_t CODE_EXPLICIT = 15;
+    constexpr uint32_t CODE_EDGE_MISS = 15;
+
+    constexpr uint32_t FIFO_SIZE = 16;
+    constexpr uint32_t FIFO_MASK = FIFO_SIZE - 1;
+
+    //---------------------------------------------------------------------------------
+    // Decoder lookup tables. The counts of explicit vertices and edge misses for each code
+    // or aux byte are packed so section sizes can be summed without branching, and the
+    // per vertex code masks let every code take the same path.
+    //---------------------------------------------------------------------------------
+    constexpr uint32_t COUNT_MISS_SHIFT = 32;
+    constexpr uint64_t COUNT_EXPLICIT_MASK = UINT32_MAX;
+
+    struct code_tables
+    {
+        uint64_t code[256];
+        uint64_t aux[256];
+        uint32_t nextMask[16];
+        uint32_t addedMask[16];
+        uint32_t explicitStep[16];
+
+        constexpr code_tables() noexcept : code{}, aux{}, nextMask{}, addedMask{}, explicitStep{}
+        {
+            nextMask[CODE_NEXT] = UINT32_MAX;
+            addedMask[CODE_NEXT] = addedMask[CODE_EXPLICIT] = UINT32_MAX;
+            explicitStep[CODE_EXPLICIT] = 1;
+
+            for (uint32_t j = 0; j < 256; ++j)
+            {
+                const uint64_t hi = ((j >> 4) == CODE_EXPLICIT) ? 1u : 0u;
+                const uint64_t lo = ((j & 0xF) == CODE_EXPLICIT) ? 1u : 0u;
+
+                code[j] = lo | (((j >> 4) == CODE_EDGE_MISS) ? (uint64_t(1) << COUNT_MISS_SHIFT) : 0);
+                aux[j] = hi + lo;
+            }
+        }
+    };
+
+    constexpr code_tables c_CodeTables;
+
+    //---------------------------------------------------------------------------------
+    // Encoder state; DecodeIBImpl keeps the same FIFOs inline
+    //---------------------------------------------------------------------------------
+    class codec_state
+    {
+    public:
+        codec_state() noexcept :
+            mEdges{},
+            mVerts{},
+            mEdgeOffset(0),
+            mVertOffset(0),
+            mNext(0),
+            mLast(0)
+        {
+            // Start with entries that can never match a real edge or vertex
+            for (auto& it : mEdges)
+            {
+                it[0] = it[1] = UNUSED32;
+            }
+            for (auto& it : mVerts)
+            {
+                it = UNUSED32;
+            }
+        }
+
+        uint32_t findedge(uint32_t a, uint32_t b) const noexcept
+        {
+            for (uint32_t j = 0; j < (FIFO_SIZE - 1); ++j)
+            {
+                const uint32_t* e = mEdges[(mEdgeOffset - 1 - j) & FIFO_MASK];
+                if (e[0] == a && e[1] == b)
+                    return j;
+            }
+
+            return UNUSED32;
+        }
+
+        void pushedge(uint32_t a, uint32_t b) noexcept
+        {
+            uint32_t* e = mEdges[mEdgeOffset & FIFO_MASK];
+            e[0] = a;
+            e[1] = b;
+            ++mEdgeOffset;
+        }
+
+        // Pushes the reversed edges of the triangle, which is how neighbors will see them
+        void pushtriangle(uint32_t a, uint32_t b, uint32_t c, bool includeFirst) noexcept
+        {
+            if (includeFirst)
+            {
+                pushedge(b, a);
+            }
+            pushedge(c, b);
+            pushedge(a, c);
+        }
+
+        uint32_t vertexcode(uint32_t v) const noexcept
+        {
+            if (v == mNext)
+                return CODE_NEXT;
+
+            for (uint32_t j = 0; j < (CODE_EXPLICIT - 1); ++j)
+            {
+                if (mVerts[(mVertOffset - 1 - j) & FIFO_MASK] == v)
+                    return j + 1;
+            }
+
+            return CODE_EXPLICIT;
+        }
+
+        // Updates the FIFO after a vertex has been coded
+        void usevertex(uint32_t v, uint32_t code) noexcept
+        {
+            if (code == CODE_NEXT)
+            {
+                ++mNext;
+            }
+            else if (code == CODE_EXPLICIT)
+            {
+                mLast = v;
+            }
+            else
+            {
+                return;
+            }
+
+            mVerts[mVertOffset & FIFO_MASK] = v;
+            ++mVertOffset;
+        }
+
+        uint32_t last() const noexcept { return mLast; }
+
+    private:
+        uint32_t mEdges[FIFO_SIZE][2];
+        uint32_t mVerts[FIFO_SIZE];
+        uint32_t mEdgeOffset;
+        uint32_t mVertOffset;
+        uint32_t mNext;
+        uint32_t mLast;
+    };
+
+    //---------------------------------------------------------------------------------
+    inline void EncodeVertex(std::vector<uint8_t>& encoded, uint32_t v, uint32_t last)
+    {
+        const uint32_t delta = v - last;
+        uint32_t zigzag = (delta << 1) ^ (0u - (delta >> 31));
+
+        while (zigzag >= 0x80)
+        {
+            encoded.push_back(static_cast<uint8_t>(zigzag | 0x80));
+            zigzag >>= 7;
+        }
+        encoded.push_back(static_cast<uint8_t>(zigzag));
+    }
+
+    inline bool DecodeVertex(const uint8_t*& ptr, const uint8_t* end, uint32_t last, uint32_t& v) noexcept
+    {
+        uint32_t zigzag = 0;
+        for (uint32_t shift = 0; shift < 35; shift += 7)
+        {
+            if (ptr >= end)
+                return false;
+
+            const uint32_t byte = *ptr++;
+            zigzag |= (byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                v = last + ((zigzag >> 1) ^ (0u - (zigzag & 1)));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT EncodeIBImpl(
+        _In_reads_(nFaces * 3) const index_t* indices,
+        size_t nFaces,
+        std::vector<uint8_t>& encoded)
+    {
+        if (!indices || !nFaces)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        encoded.clear();
+        encoded.reserve(nFaces + nFaces / 4 + 16);
+        encoded.resize(1 + nFaces);
+        encoded[0] = IBCODEC_HEADER;
+
+        std::vector<uint8_t> aux;
+        std::vector<uint8_t> explicitIndices;
+
+        codec_state state;
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            uint32_t tri[3];
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const index_t v = indices[face * 3 + j];
+                tri[j] = (v == index_t(-1)) ? UNUSED32 : uint32_t(v);
+            }
+
+            // Rotate the triangle so a shared edge comes first; unused faces are always coded explicitly
+            const bool unused = (tri[0] == UNUSED32 || tri[1] == UNUSED32 || tri[2] == UNUSED32);
+
+            uint32_t fe = UNUSED32;
+            for (size_t r = 0; r < 3 && !unused; ++r)
+            {
+                fe = state.findedge(tri[r], tri[(r + 1) % 3]);
+                if (fe != UNUSED32)
+                {
+                    if (r > 0)
+                    {
+                        const uint32_t a = tri[r];
+                        const uint32_t b = tri[(r + 1) % 3];
+                        const uint32_t c = tri[(r + 2) % 3];
+                        tri[0] = a;
+                        tri[1] = b;
+                        tri[2] = c;
+                    }
+                    break;
+                }
+            }
+
+            if (fe != UNUSED32)
+            {
+                const uint32_t c = tri[2];
+                const uint32_t fc = state.vertexcode(c);
+                encoded[1 + face] = static_cast<uint8_t>((fe << 4) | fc);
+                if (fc == CODE_EXPLICIT)
+                {
+                    EncodeVertex(explicitIndices, c, state.last());
+                }
+                state.usevertex(c, fc);
+
+                state.pushtriangle(tri[0], tri[1], tri[2], false);
+            }
+            else
+            {
+                uint32_t codes[3] = {};
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    codes[j] = state.vertexcode(tri[j]);
+                    if (codes[j] == CODE_EXPLICIT)
+                    {
+                        EncodeVertex(explicitIndices, tri[j], state.last());
+                    }
+                    state.usevertex(tri[j], codes[j]);
+                }
+
+                encoded[1 + face] = static_cast<uint8_t>((CODE_EDGE_MISS << 4) | codes[0]);
+                aux.push_back(static_cast<uint8_t>((codes[1] << 4) | codes[2]));
+
+                state.pushtriangle(tri[0], tri[1], tri[2], true);
+            }
+        }
+
+        encoded.insert(encoded.end(), aux.cbegin(), aux.cend());
+        encoded.insert(encoded.end(), explicitIndices.cbegin(), explicitIndices.cend());
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT DecodeIBImpl(
+        _In_reads_bytes_(encodedSize) const uint8_t* encoded,
+        size_t encodedSize,
+        size_t nFaces,
+        _Out_writes_(nFaces * 3) index_t* indices) noexcept
+    {
+        if (!encoded || !encodedSize || !nFaces || !indices)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        if (encoded[0] != IBCODEC_HEADER)
+            return HRESULT_E_INVALID_DATA;
+
+        if ((encodedSize - 1) < nFaces)
+            return HRESULT_E_INVALID_DATA;
+
+        // The section sizes follow from the code bytes alone
+        const uint8_t* codes = encoded + 1;
+
+        uint64_t counts = 0;
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            counts += c_CodeTables.code[codes[face]];
+        }
+
+        const auto misses = static_cast<size_t>(counts >> COUNT_MISS_SHIFT);
+        if ((encodedSize - 1 - nFaces) < misses)
+            return HRESULT_E_INVALID_DATA;
+
+        const uint8_t* aux = codes + nFaces;
+        for (size_t j = 0; j < misses; ++j)
+        {
+            counts += c_CodeTables.aux[aux[j]];
+        }
+
+        const auto explicitCount = static_cast<size_t>(counts & COUNT_EXPLICIT_MASK);
+
+        // Explicit indices are decoded up front so the main loop never parses them
+        std::unique_ptr<uint32_t[]> explicitIndices(new (std::nothrow) uint32_t[explicitCount + 1]);
+        if (!explicitIndices)
+            return E_OUTOFMEMORY;
+
+        const uint8_t* ptr = aux + misses;
+        const uint8_t* end = encoded + encodedSize;
+
+        uint32_t last = 0;
+        for (size_t j = 0; j < explicitCount; ++j)
+        {
+            uint32_t v;
+            if (!DecodeVertex(ptr, end, last, v))
+                return HRESULT_E_INVALID_DATA;
+
+            if (v != UNUSED32 && v > index_t(-1))
+                return HRESULT_E_INVALID_DATA;
+
+            explicitIndices[j] = last = v;
+        }
+
+        if (ptr != end)
+            return HRESULT_E_INVALID_DATA;
+
+        explicitIndices[explicitCount] = UNUSED32;
+
+        // Same FIFOs as codec_state
+        uint32_t edges[FIFO_SIZE][2];
+        uint32_t verts[FIFO_SIZE];
+        for (uint32_t j = 0; j < FIFO_SIZE; ++j)
+        {
+            edges[j][0] = edges[j][1] = UNUSED32;
+            verts[j] = UNUSED32;
+        }
+
+        uint32_t edgeOffset = 0;
+        uint32_t vertOffset = 0;
+        uint32_t next = 0;
+        const uint32_t* nextExplicit = explicitIndices.get();
+
+        // Every vertex code takes the same path: the value a new vertex would get is
+        // written to the FIFO ahead of time and only kept if the code asks for it
+        auto vertex = [&](uint32_t code) noexcept -> uint32_t
+            {
+                const uint32_t fifo = verts[(vertOffset - code) & FIFO_MASK];
+
+                const uint32_t nextMask = c_CodeTables.nextMask[code];
+                const uint32_t addedMask = c_CodeTables.addedMask[code];
+
+                const uint32_t added = *nextExplicit + ((next - *nextExplicit) & nextMask);
+                verts[vertOffset & FIFO_MASK] = added;
+
+                next -= nextMask;
+                nextExplicit += c_CodeTables.explicitStep[code];
+                vertOffset -= addedMask;
+                return fifo + ((added - fifo) & addedMask);
+            };
+
+        auto pushedge = [&](uint32_t a, uint32_t b) noexcept
+            {
+                uint32_t* e = edges[edgeOffset & FIFO_MASK];
+                e[0] = a;
+                e[1] = b;
+                ++edgeOffset;
+            };
+
+        index_t* dest = indices;
+        for (size_t face = 0; face < nFaces; ++face, dest += 3)
+        {
+            const uint32_t code = codes[face];
+            const uint32_t fe = code >> 4;
+
+            uint32_t a, b, c;
+            if (fe != CODE_EDGE_MISS)
+            {
+                const uint32_t* e = edges[(edgeOffset - 1 - fe) & FIFO_MASK];
+                a = e[0];
+                b = e[1];
+                c = vertex(code & 0xF);
+            }
+            else
+            {
+                const uint32_t codes12 = *aux++;
+                a = vertex(code & 0xF);
+                b = vertex(codes12 >> 4);
+                c = vertex(codes12 & 0xF);
+
+                pushedge(b, a);
+            }
+
+            pushedge(c, b);
+            pushedge(a, c);
+
+            dest[0] = static_cast<index_t>(a);
+            dest[1] = static_cast<index_t>(b);
+            dest[2] = static_cast<index_t>(c);
+        }
+
+        // New indices are handed out in order, so only the last one needs a range check
+        if (uint64_t(next) > (uint64_t(index_t(-1)) + 1))
+            return HRESULT_E_INVALID_DATA;
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::EncodeIB(
+    const uint16_t* indices,
+    size_t nFaces,
+    std::vector<uint8_t>& encoded)
+{
+    return EncodeIBImpl<uint16_t>(indices, nFaces, encoded);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::EncodeIB(
+    const uint32_t* indices,
+    size_t nFaces,
+    std::vector<uint8_t>& encoded)
+{
+    return EncodeIBImpl<uint32_t>(indices, nFaces, encoded);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::DecodeIB(
+    const uint8_t* encoded,
+    size_t encodedSize,
+    size_t nFaces,
+    uint16_t* indices) noexcept
+{
+    return DecodeIBImpl<uint16_t>(encoded, encodedSize, nFaces, indices);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::DecodeIB(
+    const uint8_t* encoded,
+    size_t encodedSize,
+    size_t nFaces,
+    uint32_t* indices) noexcept
+{
+    return DecodeIBImpl<uint32_t>(encoded, encodedSize, nFaces, indices);
+}
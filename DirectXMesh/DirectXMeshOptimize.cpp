@@ -15,6 +15,10 @@ using namespace DirectX;
 
 namespace
 {
+    constexpr uint32_t c_RadixBits = 8;
+    constexpr size_t c_RadixBuckets = size_t(1) << c_RadixBits;
+    constexpr size_t c_SortBlockSize = 65536;
+
     template<class index_t>
     HRESULT OptimizeVerticesImpl(
         _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
@@ -86,6 +90,324 @@ namespace
 
         return S_OK;
     }
+
+    //---------------------------------------------------------------------------------
+    // Orders vertices by their last use, with unused vertices left as UNUSED32 at the end
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    void LastUseOrder(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        size_t nVerts, _Out_writes_(nVerts) uint32_t* vertexRemap,
+        _Out_writes_(nVerts) uint32_t* temp) noexcept
+    {
+        memset(temp, 0xff, sizeof(uint32_t) * nVerts);
+
+        // Walking the faces backwards finds vertices in reverse order of last use
+        size_t used = 0;
+        for (size_t face = nFaces; face-- > 0; )
+        {
+            for (size_t k = 3; k-- > 0; )
+            {
+                const index_t v = indices[face * 3 + k];
+                if (v != index_t(-1) && temp[v] == UNUSED32)
+                {
+                    temp[v] = 0;
+                    vertexRemap[used++] = v;
+                }
+            }
+        }
+
+        std::reverse(vertexRemap, vertexRemap + used);
+
+        for (; used < nVerts; ++used)
+        {
+            vertexRemap[used] = UNUSED32;
+        }
+    }
+
+    template<class index_t>
+    HRESULT VertexFetchCost(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, size_t nStreams,
+        _In_reads_(nVerts) const uint32_t* vertexRemap,
+        _Out_writes_(nVerts) uint32_t* inverseRemap,
+        _Out_writes_(nFaces * 3) index_t* remappedIndices,
+        _Out_writes_(nStreams) VertexFetchStats* stats,
+        size_t lineSize, size_t cacheSize,
+        uint64_t& cost) noexcept
+    {
+        for (uint32_t j = 0; j < nVerts; ++j)
+        {
+            if (vertexRemap[j] != UNUSED32)
+            {
+                inverseRemap[vertexRemap[j]] = j;
+            }
+        }
+
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            const index_t v = indices[j];
+            remappedIndices[j] = (v == index_t(-1)) ? v : static_cast<index_t>(inverseRemap[v]);
+        }
+
+        HRESULT hr = ComputeVertexFetchStats(remappedIndices, nFaces, nVerts, strides, nStreams, stats, lineSize, cacheSize);
+        if (FAILED(hr))
+            return hr;
+
+        cost = 0;
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            cost += stats[s].BytesFetched;
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Packs vertices into the cache lines of the narrowest stream: each line is led by the
+    // next vertex in first use order and filled with the vertices first used within the
+    // following cache window whose last use is closest to the leader's, so a line is not
+    // fetched again for a few of its vertices after the rest are done
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    void PackedFetchOrder(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, size_t nStreams,
+        _In_reads_(nVerts) const uint32_t* firstUse, size_t used,
+        size_t lineSize, size_t cacheSize,
+        _Out_writes_(nVerts) uint32_t* vertexRemap,
+        _Out_writes_(nVerts) uint32_t* lastFace,
+        _Out_writes_(nVerts) uint8_t* taken,
+        _Out_writes_(maxLine) uint32_t* line, size_t maxLine) noexcept
+    {
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            const index_t v = indices[j];
+            if (v != index_t(-1))
+            {
+                lastFace[v] = static_cast<uint32_t>(j / 3);
+            }
+        }
+
+        size_t minStride = strides[0];
+        size_t vertexBytes = 0;
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            minStride = std::min(minStride, strides[s]);
+            vertexBytes += strides[s];
+        }
+
+        // Candidates are limited to about a quarter of the vertices the cache holds at once
+        const size_t perLine = std::min(std::max<size_t>(lineSize / minStride, 1), maxLine);
+        const size_t window = std::max(cacheSize / (vertexBytes * 4), perLine);
+
+        memset(taken, 0, sizeof(uint8_t) * used);
+
+        size_t placed = 0;
+        size_t cur = 0;
+        while (placed < used)
+        {
+            while (taken[cur])
+                ++cur;
+
+            taken[cur] = 1;
+            const uint32_t leadFace = lastFace[firstUse[cur]];
+            auto distance = [&](size_t j) noexcept -> uint32_t
+                {
+                    const uint32_t face = lastFace[firstUse[j]];
+                    return (face > leadFace) ? (face - leadFace) : (leadFace - face);
+                };
+
+            // Line holds first use positions sorted by distance in last use from the leader
+            size_t count = 0;
+            size_t scanned = 0;
+            for (size_t j = cur + 1; j < used && scanned < window; ++j)
+            {
+                if (taken[j])
+                    continue;
+
+                ++scanned;
+
+                const uint32_t dist = distance(j);
+                if (count == perLine - 1 && (!count || dist >= distance(line[count - 1])))
+                    continue;
+
+                size_t k = (count < perLine - 1) ? count++ : count - 1;
+                for (; k > 0 && dist < distance(line[k - 1]); --k)
+                {
+                    line[k] = line[k - 1];
+                }
+
+                line[k] = static_cast<uint32_t>(j);
+            }
+
+            // Keep first use order within the line
+            std::sort(line, line + count);
+
+            vertexRemap[placed++] = firstUse[cur];
+            for (size_t k = 0; k < count; ++k)
+            {
+                taken[line[k]] = 1;
+                vertexRemap[placed++] = firstUse[line[k]];
+            }
+        }
+
+        for (; placed < nVerts; ++placed)
+        {
+            vertexRemap[placed] = UNUSED32;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Builds a vertex order from the vertex fetch model, and keeps first use or last use
+    // order instead if either fetches fewer bytes
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeVerticesForFetchImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, size_t nStreams,
+        _Out_writes_(nVerts) uint32_t* vertexRemap,
+        _Out_opt_ size_t* trailingUnused,
+        size_t lineSize, size_t cacheSize) noexcept
+    {
+        if (!strides || !nStreams)
+            return E_INVALIDARG;
+
+        // First use order is the baseline candidate, and validates the input
+        size_t unused = 0;
+        HRESULT hr = OptimizeVerticesImpl<index_t>(indices, nFaces, nVerts, vertexRemap, &unused);
+        if (FAILED(hr))
+            return hr;
+
+        if (trailingUnused)
+        {
+            *trailingUnused = unused;
+        }
+
+        std::unique_ptr<uint32_t[]> candidate(new (std::nothrow) uint32_t[nVerts]);
+        std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nVerts]);
+        std::unique_ptr<uint8_t[]> taken(new (std::nothrow) uint8_t[nVerts]);
+        std::unique_ptr<index_t[]> remappedIndices(new (std::nothrow) index_t[nFaces * 3]);
+        std::unique_ptr<VertexFetchStats[]> stats(new (std::nothrow) VertexFetchStats[nStreams]);
+        if (!candidate || !temp || !taken || !remappedIndices || !stats)
+            return E_OUTOFMEMORY;
+
+        // Also validates the strides and cache geometry used to pack the lines
+        uint64_t bestCost = 0;
+        hr = VertexFetchCost<index_t>(indices, nFaces, nVerts, strides, nStreams,
+            vertexRemap, temp.get(), remappedIndices.get(), stats.get(), lineSize, cacheSize, bestCost);
+        if (FAILED(hr))
+            return hr;
+
+        constexpr size_t c_MaxLineVertices = 64;
+        uint32_t line[c_MaxLineVertices];
+
+        PackedFetchOrder<index_t>(indices, nFaces, nVerts, strides, nStreams, vertexRemap, nVerts - unused,
+            lineSize, cacheSize, candidate.get(), temp.get(), taken.get(), line, c_MaxLineVertices);
+
+        uint64_t cost = 0;
+        hr = VertexFetchCost<index_t>(indices, nFaces, nVerts, strides, nStreams,
+            candidate.get(), temp.get(), remappedIndices.get(), stats.get(), lineSize, cacheSize, cost);
+        if (FAILED(hr))
+            return hr;
+
+        if (cost < bestCost)
+        {
+            memcpy(vertexRemap, candidate.get(), sizeof(uint32_t) * nVerts);
+            bestCost = cost;
+        }
+
+        // Grouping vertices by their last use keeps lines together that are revisited together,
+        // which can beat first use order when vertices are referenced again long after first use
+        LastUseOrder<index_t>(indices, nFaces, nVerts, candidate.get(), temp.get());
+
+        hr = VertexFetchCost<index_t>(indices, nFaces, nVerts, strides, nStreams,
+            candidate.get(), temp.get(), remappedIndices.get(), stats.get(), lineSize, cacheSize, cost);
+        if (FAILED(hr))
+            return hr;
+
+        if (cost < bestCost)
+        {
+            memcpy(vertexRemap, candidate.get(), sizeof(uint32_t) * nVerts);
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT GenerateShadowIBImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nVerts) const uint32_t* pointRep,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces * 3) index_t* shadowIndices,
+        _Out_writes_(nVerts) uint32_t* shadowVertexRemap,
+        _Out_opt_ size_t* trailingUnused,
+        uint32_t lruCacheSize)
+    {
+        if (!indices || !nFaces || !nVerts || !pointRep || !shadowIndices || !shadowVertexRemap)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        if (trailingUnused)
+        {
+            *trailingUnused = 0;
+        }
+
+        // Vertices sharing a position collapse onto their point representative
+        std::unique_ptr<index_t[]> welded(new (std::nothrow) index_t[nFaces * 3]);
+        std::unique_ptr<uint32_t[]> faceRemap(new (std::nothrow) uint32_t[nFaces]);
+        if (!welded || !faceRemap)
+            return E_OUTOFMEMORY;
+
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            const index_t v = indices[j];
+            if (v == index_t(-1))
+            {
+                welded[j] = v;
+                continue;
+            }
+
+            if (v >= nVerts)
+                return E_UNEXPECTED;
+
+            const uint32_t rep = pointRep[v];
+            if (rep >= nVerts)
+                return E_UNEXPECTED;
+
+            welded[j] = static_cast<index_t>(rep);
+        }
+
+        // The welded buffer has different sharing than the original, so it is optimized on its own
+        HRESULT hr = (attributes)
+            ? OptimizeFacesLRUEx(welded.get(), nFaces, nVerts, attributes, faceRemap.get(), lruCacheSize)
+            : OptimizeFacesLRU(welded.get(), nFaces, nVerts, faceRemap.get(), lruCacheSize);
+        if (FAILED(hr))
+            return hr;
+
+        // Unused faces have no remap entry, so they are left as unused faces at the end
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            shadowIndices[j] = index_t(-1);
+        }
+
+        hr = ReorderIB(welded.get(), nFaces, faceRemap.get(), shadowIndices);
+        if (FAILED(hr))
+            return hr;
+
+        hr = OptimizeVerticesImpl<index_t>(shadowIndices, nFaces, nVerts, shadowVertexRemap, trailingUnused);
+        if (FAILED(hr))
+            return hr;
+
+        return FinalizeIB(shadowIndices, nFaces, shadowVertexRemap, nVerts);
+    }
 }
 
 //=====================================================================================
@@ -104,25 +426,109 @@ HRESULT DirectX::AttributeSort(
     if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
         return HRESULT_E_ARITHMETIC_OVERFLOW;
 
-    using intpair_t = std::pair<uint32_t, uint32_t>;
+    // Stable LSD radix sort on the attribute offset from the smallest value, which for
+    // typical material ids needs a single pass
+    uint32_t minAttr = attributes[0];
+    uint32_t maxAttr = attributes[0];
+    for (size_t j = 1; j < nFaces; ++j)
+    {
+        minAttr = std::min(minAttr, attributes[j]);
+        maxAttr = std::max(maxAttr, attributes[j]);
+    }
 
-    std::vector<intpair_t> list;
-    list.reserve(nFaces);
-    for (size_t j = 0; j < nFaces; ++j)
+    const uint32_t range = maxAttr - minAttr;
+    size_t passes = 0;
+    for (uint32_t r = range; r != 0; r >>= c_RadixBits)
     {
-        list.emplace_back(intpair_t(attributes[j], static_cast<uint32_t>(j)));
+        ++passes;
     }
 
-    std::stable_sort(list.begin(), list.end(), [](const intpair_t& a, const intpair_t& b) noexcept -> bool
+    if (!passes)
+    {
+        // All faces share one attribute
+        for (size_t j = 0; j < nFaces; ++j)
         {
-            return (a.first < b.first);
-        });
+            faceRemap[j] = static_cast<uint32_t>(j);
+        }
 
-    auto it = list.begin();
-    for (size_t j = 0; j < nFaces; ++j, ++it)
+        return S_OK;
+    }
+
+    const int count = static_cast<int>((nFaces + c_SortBlockSize - 1) / c_SortBlockSize);
+
+    std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nFaces * 2]);
+    std::unique_ptr<size_t[]> offsets(new (std::nothrow) size_t[size_t(count) * c_RadixBuckets]);
+    if (!temp || !offsets)
+        return E_OUTOFMEMORY;
+
+    // Ping-pong between the temp buffers and the output arrays, ending in the output arrays
+    uint32_t* keys[2] = { temp.get(), attributes };
+    uint32_t* faces[2] = { temp.get() + nFaces, faceRemap };
+
+    const size_t first = (passes & 1) ? 0 : 1;
+    if (keys[first] != attributes)
+    {
+        memcpy(keys[first], attributes, sizeof(uint32_t) * nFaces);
+    }
+    for (size_t j = 0; j < nFaces; ++j)
     {
-        attributes[j] = it->first;
-        faceRemap[j] = it->second;
+        faces[first][j] = static_cast<uint32_t>(j);
+    }
+
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+        const uint32_t* srcKeys = keys[(first + pass) & 1];
+        const uint32_t* srcFaces = faces[(first + pass) & 1];
+        uint32_t* destKeys = keys[(first + pass + 1) & 1];
+        uint32_t* destFaces = faces[(first + pass + 1) & 1];
+        const uint32_t shift = static_cast<uint32_t>(pass * c_RadixBits);
+
+        // Histogram of each block of faces
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            size_t* hist = &offsets[size_t(block) * c_RadixBuckets];
+            memset(hist, 0, sizeof(size_t) * c_RadixBuckets);
+
+            const size_t start = size_t(block) * c_SortBlockSize;
+            const size_t end = std::min(start + c_SortBlockSize, nFaces);
+            for (size_t j = start; j < end; ++j)
+            {
+                ++hist[((srcKeys[j] - minAttr) >> shift) & (c_RadixBuckets - 1)];
+            }
+        }
+
+        // Bucket-major prefix sum keeps earlier blocks ahead of later ones, so the sort is stable
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < c_RadixBuckets; ++bucket)
+        {
+            for (int block = 0; block < count; ++block)
+            {
+                size_t& entry = offsets[size_t(block) * c_RadixBuckets + bucket];
+                const size_t n = entry;
+                entry = total;
+                total += n;
+            }
+        }
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            size_t* next = &offsets[size_t(block) * c_RadixBuckets];
+
+            const size_t start = size_t(block) * c_SortBlockSize;
+            const size_t end = std::min(start + c_SortBlockSize, nFaces);
+            for (size_t j = start; j < end; ++j)
+            {
+                const size_t dest = next[((srcKeys[j] - minAttr) >> shift) & (c_RadixBuckets - 1)]++;
+                destKeys[dest] = srcKeys[j];
+                destFaces[dest] = srcFaces[j];
+            }
+        }
     }
 
     return S_OK;
@@ -151,3 +557,67 @@ HRESULT DirectX::OptimizeVertices(
 {
     return OptimizeVerticesImpl<uint32_t>(indices, nFaces, nVerts, vertexRemap, trailingUnused);
 }
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeVerticesForFetch(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const size_t* strides,
+    size_t nStreams,
+    uint32_t* vertexRemap,
+    size_t* trailingUnused,
+    size_t lineSize,
+    size_t cacheSize) noexcept
+{
+    return OptimizeVerticesForFetchImpl<uint16_t>(indices, nFaces, nVerts, strides, nStreams, vertexRemap, trailingUnused, lineSize, cacheSize);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeVerticesForFetch(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const size_t* strides,
+    size_t nStreams,
+    uint32_t* vertexRemap,
+    size_t* trailingUnused,
+    size_t lineSize,
+    size_t cacheSize) noexcept
+{
+    return OptimizeVerticesForFetchImpl<uint32_t>(indices, nFaces, nVerts, strides, nStreams, vertexRemap, trailingUnused, lineSize, cacheSize);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::GenerateShadowIB(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* pointRep,
+    const uint32_t* attributes,
+    uint16_t* shadowIndices,
+    uint32_t* shadowVertexRemap,
+    size_t* trailingUnused,
+    uint32_t lruCacheSize)
+{
+    return GenerateShadowIBImpl<uint16_t>(indices, nFaces, nVerts, pointRep, attributes, shadowIndices, shadowVertexRemap, trailingUnused, lruCacheSize);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateShadowIB(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* pointRep,
+    const uint32_t* attributes,
+    uint32_t* shadowIndices,
+    uint32_t* shadowVertexRemap,
+    size_t* trailingUnused,
+    uint32_t lruCacheSize)
+{
+    return GenerateShadowIBImpl<uint32_t>(indices, nFaces, nVerts, pointRep, attributes, shadowIndices, shadowVertexRemap, trailingUnused, lruCacheSize);
+}
@@ -166,30 +166,113 @@ namespace
         }
     };
 
-    template <typename T, typename IndexType>
-    struct FaceValenceSort
+    // Unprocessed faces bucketed by the total number of active faces using their vertices.
+    // Lower totals make better starting points. Totals only ever decrease, so each update
+    // is O(1) and finding the best face is amortized O(1).
+    class FaceValenceQueue
     {
-        const OptimizeVertexData<IndexType> *_vertexData;
+    public:
+        FaceValenceQueue() noexcept : mMinValence(0), mMaxValence(0) {}
 
-        FaceValenceSort(const OptimizeVertexData<IndexType> *vertexData) noexcept : _vertexData(vertexData) {}
+        HRESULT initialize(uint32_t faceCount, uint32_t maxValence) noexcept
+        {
+            mValence.reset(new (std::nothrow) uint32_t[faceCount]);
+            mNext.reset(new (std::nothrow) uint32_t[faceCount]);
+            mPrev.reset(new (std::nothrow) uint32_t[faceCount]);
+            mHead.reset(new (std::nothrow) uint32_t[size_t(maxValence) + 1]);
+            mTail.reset(new (std::nothrow) uint32_t[size_t(maxValence) + 1]);
+            if (!mValence || !mNext || !mPrev || !mHead || !mTail)
+                return E_OUTOFMEMORY;
 
-        bool operator()(T a, T b) const noexcept
+            memset(mValence.get(), 0xff, sizeof(uint32_t) * faceCount);
+            memset(mHead.get(), 0xff, sizeof(uint32_t) * (size_t(maxValence) + 1));
+            memset(mTail.get(), 0xff, sizeof(uint32_t) * (size_t(maxValence) + 1));
+
+            mMinValence = maxValence;
+            mMaxValence = maxValence;
+            return S_OK;
+        }
+
+        void push_back(uint32_t face, uint32_t valence) noexcept
         {
-            const OptimizeVertexData<IndexType> *vA = _vertexData + size_t(a) * 3;
-            const OptimizeVertexData<IndexType> *vB = _vertexData + size_t(b) * 3;
+            assert(valence <= mMaxValence);
 
-            const uint32_t aValence = vA[0].activeFaceListSize + vA[1].activeFaceListSize + vA[2].activeFaceListSize;
-            const uint32_t bValence = vB[0].activeFaceListSize + vB[1].activeFaceListSize + vB[2].activeFaceListSize;
+            mValence[face] = valence;
+            mNext[face] = UNUSED32;
+            mPrev[face] = mTail[valence];
 
-            // higher scoring faces are those with lower valence totals
+            if (mTail[valence] != UNUSED32)
+            {
+                mNext[mTail[valence]] = face;
+            }
+            else
+            {
+                mHead[valence] = face;
+            }
 
-            // reverse sort (reverse of reverse)
+            mTail[valence] = face;
+            mMinValence = std::min(mMinValence, valence);
+        }
 
-            if (aValence < bValence)
-                return true;
+        void remove(uint32_t face) noexcept
+        {
+            const uint32_t valence = mValence[face];
+            if (valence == UNUSED32)
+                return;
 
-            return false;
+            if (mPrev[face] != UNUSED32)
+            {
+                mNext[mPrev[face]] = mNext[face];
+            }
+            else
+            {
+                mHead[valence] = mNext[face];
+            }
+
+            if (mNext[face] != UNUSED32)
+            {
+                mPrev[mNext[face]] = mPrev[face];
+            }
+            else
+            {
+                mTail[valence] = mPrev[face];
+            }
+
+            mValence[face] = UNUSED32;
         }
+
+        // Moves the face to the end of the next lower bucket, matching the order a stable re-sort would produce
+        void decrement(uint32_t face) noexcept
+        {
+            const uint32_t valence = mValence[face];
+            if (valence == UNUSED32 || !valence)
+                return;
+
+            remove(face);
+            push_back(face, valence - 1);
+        }
+
+        uint32_t front() noexcept
+        {
+            while (mMinValence <= mMaxValence)
+            {
+                if (mHead[mMinValence] != UNUSED32)
+                    return mHead[mMinValence];
+
+                ++mMinValence;
+            }
+
+            return UNUSED32;
+        }
+
+    private:
+        std::unique_ptr<uint32_t[]> mValence;
+        std::unique_ptr<uint32_t[]> mNext;
+        std::unique_ptr<uint32_t[]> mPrev;
+        std::unique_ptr<uint32_t[]> mHead;
+        std::unique_ptr<uint32_t[]> mTail;
+        uint32_t                    mMinValence;
+        uint32_t                    mMaxValence;
     };
 
     template <typename IndexType>
@@ -209,9 +292,7 @@ namespace
         const uint32_t faceCount = indexCount / 3;
 
         std::unique_ptr<uint8_t[]> processedFaceList(new (std::nothrow) uint8_t[faceCount]);
-        std::unique_ptr<uint32_t[]> faceSorted(new (std::nothrow) uint32_t[faceCount]);
-        std::unique_ptr<uint32_t[]> faceReverseLookup(new (std::nothrow) uint32_t[faceCount]);
-        if (!processedFaceList || !faceSorted || !faceReverseLookup)
+        if (!processedFaceList)
             return E_OUTOFMEMORY;
 
         memset(processedFaceList.get(), 0, sizeof(uint8_t) * faceCount);
@@ -295,20 +376,6 @@ namespace
         #endif
         }
 
-        // sort unprocessed faces by highest score
-        for (uint32_t f = 0; f < faceCount; f++)
-        {
-            faceSorted[f] = f;
-        }
-
-        const FaceValenceSort<uint32_t, IndexType> faceValenceSort(vertexDataList.get());
-        std::sort(faceSorted.get(), faceSorted.get() + faceCount, faceValenceSort);
-
-        for (uint32_t f = 0; f < faceCount; f++)
-        {
-            faceReverseLookup[faceSorted[f]] = f;
-        }
-
         // fill out face list per vertex
         for (uint32_t i = 0; i < indexCount; i += 3)
         {
@@ -324,6 +391,40 @@ namespace
             }
         }
 
+        // queue unprocessed faces by lowest valence
+        uint32_t maxValence = 0;
+        for (uint32_t i = 0; i < indexCount; i += 3)
+        {
+            const uint32_t i0 = vertexRemap[i];
+            const uint32_t i1 = vertexRemap[size_t(i) + 1];
+            const uint32_t i2 = vertexRemap[size_t(i) + 2];
+            if (i0 != UNUSED32 && i1 != UNUSED32 && i2 != UNUSED32)
+            {
+                const uint32_t valence = vertexDataList[i0].activeFaceListSize
+                    + vertexDataList[i1].activeFaceListSize
+                    + vertexDataList[i2].activeFaceListSize;
+                maxValence = std::max(maxValence, valence);
+            }
+        }
+
+        FaceValenceQueue faceQueue;
+        HRESULT hr = faceQueue.initialize(faceCount, maxValence);
+        if (FAILED(hr))
+            return hr;
+
+        for (uint32_t i = 0; i < indexCount; i += 3)
+        {
+            const uint32_t i0 = vertexRemap[i];
+            const uint32_t i1 = vertexRemap[size_t(i) + 1];
+            const uint32_t i2 = vertexRemap[size_t(i) + 2];
+            if (i0 != UNUSED32 && i1 != UNUSED32 && i2 != UNUSED32)
+            {
+                faceQueue.push_back(i / 3, vertexDataList[i0].activeFaceListSize
+                    + vertexDataList[i1].activeFaceListSize
+                    + vertexDataList[i2].activeFaceListSize);
+            }
+        }
+
         uint32_t vertexCacheBuffer[(kMaxVertexCacheSize + 3) * 2] = {};
         uint32_t *cache0 = vertexCacheBuffer;
         uint32_t *cache1 = vertexCacheBuffer + (kMaxVertexCacheSize + 3);
@@ -345,8 +446,6 @@ namespace
 
         float bestScore = -1.f;
 
-        uint32_t nextBestFace = 0;
-
         uint32_t curFace = 0;
         for (size_t i = 0; i < indexCount; i += 3)
         {
@@ -360,31 +459,20 @@ namespace
             if (bestScore < 0.f)
             {
                 // no verts in the cache are used by any unprocessed faces so
-                // search all unprocessed faces for a new starting point
-                while (nextBestFace < faceCount)
-                {
-                    const uint32_t faceIndex = faceSorted[nextBestFace++];
-                    if (processedFaceList[faceIndex] == 0)
-                    {
-                        const uint32_t face = faceIndex * 3;
-                        const uint32_t i0 = vertexRemap[face];
-                        const uint32_t i1 = vertexRemap[size_t(face) + 1];
-                        const uint32_t i2 = vertexRemap[size_t(face) + 2];
-                        if (i0 != UNUSED32 && i1 != UNUSED32 && i2 != UNUSED32)
-                        {
-                            // we're searching a pre-sorted list, first one we find will be the best
-                            bestFace = face;
-                            bestScore = vertexDataList[i0].score
-                                + vertexDataList[i1].score
-                                + vertexDataList[i2].score;
-                            break;
-                        }
-                    }
-                }
+                // take the unprocessed face with the lowest valence as a new starting point
+                const uint32_t faceIndex = faceQueue.front();
+                assert(faceIndex != UNUSED32 && processedFaceList[faceIndex] == 0);
+
+                const uint32_t face = faceIndex * 3;
+                bestFace = face;
+                bestScore = vertexDataList[vertexRemap[face]].score
+                    + vertexDataList[vertexRemap[size_t(face) + 1]].score
+                    + vertexDataList[vertexRemap[size_t(face) + 2]].score;
                 assert(bestScore >= 0.f);
             }
 
             processedFaceList[bestFace / 3] = 1;
+            faceQueue.remove(bestFace / 3);
             uint16_t entriesInCache1 = 0;
 
             faceRemap[curFace] = (bestFace / 3) + offset;
@@ -423,28 +511,10 @@ namespace
                 --vertexData.activeFaceListSize;
                 vertexData.score = FindVertexScore(vertexData.activeFaceListSize, vertexData.cachePos1, lruCacheSize);
 
-                // need to re-sort the faces that use this vertex, as their score will change due to activeFaceListSize shrinking
+                // the faces that use this vertex move to a lower valence bucket as activeFaceListSize shrinks
                 for (const uint32_t *fi = begin; fi != end - 1; ++fi)
                 {
-                    const uint32_t faceIndex = *fi / 3;
-                    uint32_t n = faceReverseLookup[faceIndex];
-                    assert(faceSorted[n] == faceIndex);
-
-                    // found it, now move it up
-                    while (n > 0)
-                    {
-                        if (faceValenceSort(n, n - 1))
-                        {
-                            faceReverseLookup[faceSorted[n]] = n - 1;
-                            faceReverseLookup[faceSorted[n - 1]] = n;
-                            std::swap(faceSorted[n], faceSorted[n - 1]);
-                            n--;
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
+                    faceQueue.decrement(*fi / 3);
                 }
             }
 
@@ -457,7 +527,13 @@ namespace
                 {
                     vertexData.cachePos1 = entriesInCache1;
                     cache1[entriesInCache1++] = cache0[c0];
-                    vertexData.score = FindVertexScore(vertexData.activeFaceListSize, vertexData.cachePos1, lruCacheSize);
+
+                    // the active face count is unchanged, so only rescore if the cache position score differs
+                    if (vertexData.cachePos1 != vertexData.cachePos0
+                        && (vertexData.cachePos0 < lruCacheSize || vertexData.cachePos1 < lruCacheSize))
+                    {
+                        vertexData.score = FindVertexScore(vertexData.activeFaceListSize, vertexData.cachePos1, lruCacheSize);
+                    }
 
                     // don't need to re-sort this vertex... once it gets out of the cache, it'll have its original score
                 }
@@ -503,6 +579,56 @@ namespace
 
         return S_OK;
     }
+
+    //---------------------------------------------------------------------------------
+    // Attribute subsets are independent and write disjoint ranges of faceRemap
+    //---------------------------------------------------------------------------------
+    template <typename IndexType>
+    HRESULT OptimizeFacesSubsets(
+        _In_reads_(nFaces * 3) const IndexType* indices, size_t nFaces, size_t nVerts,
+        const std::vector<std::pair<size_t, size_t>>& subsets,
+        _Out_writes_(nFaces) uint32_t* faceRemap, uint32_t lruCacheSize)
+    {
+        for (const auto& it : subsets)
+        {
+            if (it.first >= nFaces)
+                return E_UNEXPECTED;
+
+            if ((uint64_t(it.first) + uint64_t(it.second)) >= UINT32_MAX)
+                return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+            const uint32_t faceMax = uint32_t(it.first + it.second);
+
+            if (faceMax > nFaces)
+                return E_UNEXPECTED;
+        }
+
+        std::unique_ptr<HRESULT[]> results(new (std::nothrow) HRESULT[subsets.size()]);
+        if (!results)
+            return E_OUTOFMEMORY;
+
+        const int count = static_cast<int>(subsets.size());
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if (count > 1)
+    #endif
+        for (int j = 0; j < count; ++j)
+        {
+            const auto& it = subsets[size_t(j)];
+
+            results[size_t(j)] = OptimizeFacesImpl<IndexType>(
+                &indices[it.first * 3], static_cast<uint32_t>(it.second * 3), nVerts,
+                &faceRemap[it.first], lruCacheSize, uint32_t(it.first));
+        }
+
+        for (size_t j = 0; j < subsets.size(); ++j)
+        {
+            if (FAILED(results[j]))
+                return results[j];
+        }
+
+        return S_OK;
+    }
 }
 
 //=====================================================================================
@@ -594,27 +720,7 @@ HRESULT DirectX::OptimizeFacesLRUEx(
 
     memset(faceRemap, 0, sizeof(uint32_t) * nFaces);
 
-    for (const auto& it : subsets)
-    {
-        if (it.first >= nFaces)
-            return E_UNEXPECTED;
-
-        if ((uint64_t(it.first) + uint64_t(it.second)) >= UINT32_MAX)
-            return HRESULT_E_ARITHMETIC_OVERFLOW;
-
-        const uint32_t faceMax = uint32_t(it.first + it.second);
-
-        if (faceMax > nFaces)
-            return E_UNEXPECTED;
-
-        HRESULT hr = OptimizeFacesImpl<uint16_t>(
-            &indices[it.first * 3], static_cast<uint32_t>(it.second * 3), nVerts,
-            &faceRemap[it.first], lruCacheSize, uint32_t(it.first));
-        if (FAILED(hr))
-            return hr;
-    }
-
-    return S_OK;
+    return OptimizeFacesSubsets<uint16_t>(indices, nFaces, nVerts, subsets, faceRemap, lruCacheSize);
 }
 
 _Use_decl_annotations_
@@ -648,25 +754,5 @@ HRESULT DirectX::OptimizeFacesLRUEx(
 
     memset(faceRemap, 0, sizeof(uint32_t) * nFaces);
 
-    for (const auto& it : subsets)
-    {
-        if (it.first >= nFaces)
-            return E_UNEXPECTED;
-
-        if ((uint64_t(it.first) + uint64_t(it.second)) >= UINT32_MAX)
-            return HRESULT_E_ARITHMETIC_OVERFLOW;
-
-        const uint32_t faceMax = uint32_t(it.first + it.second);
-
-        if (faceMax > nFaces)
-            return E_UNEXPECTED;
-
-        HRESULT hr = OptimizeFacesImpl<uint32_t>(
-            &indices[it.first * 3], static_cast<uint32_t>(it.second * 3), nVerts,
-            &faceRemap[it.first], lruCacheSize, uint32_t(it.first));
-        if (FAILED(hr))
-            return hr;
-    }
-
-    return S_OK;
+    return OptimizeFacesSubsets<uint32_t>(indices, nFaces, nVerts, subsets, faceRemap, lruCacheSize);
 }
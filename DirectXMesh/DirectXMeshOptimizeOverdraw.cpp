@@ -0,0 +1,334 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshOptimizeOverdraw.cpp
+//
+// DirectX Mesh Geometry Library - Mesh optimization
+//
+// Sander, Nehab, and Barczak "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// https://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // FIFO vertex cache simulation using per-vertex insertion timestamps
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    class fifo_cache
+    {
+    public:
+        fifo_cache(uint64_t* timestamps, uint32_t cacheSize) noexcept :
+            mTimestamps(timestamps),
+            mTime(uint64_t(cacheSize) + 1),
+            mCacheSize(cacheSize)
+        {}
+
+        // Returns the number of cache misses for the face
+        uint32_t add(_In_reads_(3) const index_t* face) noexcept
+        {
+            uint32_t misses = 0;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const index_t v = face[j];
+                if (v == index_t(-1))
+                    continue;
+
+                if ((mTime - mTimestamps[v]) > mCacheSize)
+                {
+                    mTimestamps[v] = mTime++;
+                    ++misses;
+                }
+            }
+
+            return misses;
+        }
+
+        // Evicts every vertex from the cache
+        void flush() noexcept
+        {
+            mTime += uint64_t(mCacheSize) + 1;
+        }
+
+    private:
+        uint64_t*   mTimestamps;
+        uint64_t    mTime;
+        uint32_t    mCacheSize;
+    };
+
+    struct cluster_key
+    {
+        XMFLOAT3    centroid;
+        XMFLOAT3    normal;
+        float       area;
+        float       sortKey;
+        uint32_t    start;
+        uint32_t    end;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Splits the faces [faceBegin, faceEnd) into clusters at hard and soft boundaries
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    size_t GenerateClusters(
+        _In_reads_(faceEnd * 3) const index_t* indices,
+        uint32_t faceBegin,
+        uint32_t faceEnd,
+        fifo_cache<index_t>& cache,
+        float threshold,
+        _Out_writes_(faceEnd - faceBegin) cluster_key* clusters) noexcept
+    {
+        size_t count = 0;
+
+        uint32_t hardStart = faceBegin;
+        while (hardStart < faceEnd)
+        {
+            // Hard boundaries are where the optimized order misses on every vertex of a face,
+            // which means the previous order already had to restart the cache
+            cache.flush();
+
+            uint32_t hardEnd = hardStart + 1;
+            uint32_t hardMisses = cache.add(&indices[size_t(hardStart) * 3]);
+            for (; hardEnd < faceEnd; ++hardEnd)
+            {
+                const uint32_t misses = cache.add(&indices[size_t(hardEnd) * 3]);
+                if (misses == 3)
+                    break;
+
+                hardMisses += misses;
+            }
+
+            // Soft boundaries are placed where restarting the cache keeps the local ACMR within the threshold
+            const float target = threshold * float(hardMisses) / float(hardEnd - hardStart);
+
+            cache.flush();
+
+            uint32_t softStart = hardStart;
+            uint32_t runMisses = 0;
+            for (uint32_t face = hardStart; face < hardEnd; ++face)
+            {
+                runMisses += cache.add(&indices[size_t(face) * 3]);
+
+                const uint32_t runFaces = face - softStart + 1;
+                if ((face + 1) < hardEnd && float(runMisses) <= target * float(runFaces))
+                {
+                    clusters[count].start = softStart;
+                    clusters[count].end = face + 1;
+                    ++count;
+
+                    cache.flush();
+                    softStart = face + 1;
+                    runMisses = 0;
+                }
+            }
+
+            clusters[count].start = softStart;
+            clusters[count].end = hardEnd;
+            ++count;
+
+            hardStart = hardEnd;
+        }
+
+        return count;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Sorts clusters by their view-independent occlusion potential
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    void SortClusters(
+        _In_ const index_t* indices,
+        _In_ const XMFLOAT3* positions,
+        _Inout_updates_all_(nClusters) cluster_key* clusters,
+        size_t nClusters,
+        OPTOVERDRAW_FLAGS flags) noexcept
+    {
+        // Area-weighted centroid and normal of each cluster
+        XMVECTOR meshCentroid = g_XMZero;
+        float meshArea = 0.f;
+
+        for (size_t c = 0; c < nClusters; ++c)
+        {
+            XMVECTOR centroid = g_XMZero;
+            XMVECTOR normal = g_XMZero;
+            float area = 0.f;
+
+            for (uint32_t face = clusters[c].start; face < clusters[c].end; ++face)
+            {
+                const index_t i0 = indices[size_t(face) * 3];
+                const index_t i1 = indices[size_t(face) * 3 + 1];
+                const index_t i2 = indices[size_t(face) * 3 + 2];
+
+                if (i0 == index_t(-1) || i1 == index_t(-1) || i2 == index_t(-1))
+                    continue;
+
+                const XMVECTOR p0 = XMLoadFloat3(&positions[i0]);
+                const XMVECTOR p1 = XMLoadFloat3(&positions[i1]);
+                const XMVECTOR p2 = XMLoadFloat3(&positions[i2]);
+
+                const XMVECTOR n = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+                const float faceArea = XMVectorGetX(XMVector3Length(n)) * 0.5f;
+
+                centroid = XMVectorAdd(centroid, XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), p2), faceArea / 3.f));
+                normal = XMVectorAdd(normal, n);
+                area += faceArea;
+            }
+
+            meshCentroid = XMVectorAdd(meshCentroid, centroid);
+            meshArea += area;
+
+            if (flags & OPTOVERDRAW_WIND_CW)
+            {
+                normal = XMVectorNegate(normal);
+            }
+
+            XMStoreFloat3(&clusters[c].centroid, (area > 0.f) ? XMVectorScale(centroid, 1.f / area) : XMVectorZero());
+            XMStoreFloat3(&clusters[c].normal, XMVector3Normalize(normal));
+            clusters[c].area = area;
+        }
+
+        if (meshArea > 0.f)
+        {
+            meshCentroid = XMVectorScale(meshCentroid, 1.f / meshArea);
+        }
+
+        // Clusters far out from the center and facing away from it are likely occluders, so draw them first
+        for (size_t c = 0; c < nClusters; ++c)
+        {
+            if (clusters[c].area > 0.f)
+            {
+                const XMVECTOR centroid = XMLoadFloat3(&clusters[c].centroid);
+                const XMVECTOR normal = XMLoadFloat3(&clusters[c].normal);
+                clusters[c].sortKey = XMVectorGetX(XMVector3Dot(XMVectorSubtract(centroid, meshCentroid), normal));
+            }
+            else
+            {
+                clusters[c].sortKey = 0.f;
+            }
+        }
+
+        std::sort(clusters, clusters + nClusters, [](const cluster_key& a, const cluster_key& b) noexcept -> bool
+            {
+                if (a.sortKey != b.sortKey)
+                    return a.sortKey > b.sortKey;
+
+                return a.start < b.start;
+            });
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeOverdrawImpl(
+        _In_reads_(nFaces * 3) const index_t* indices,
+        size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions,
+        size_t nVerts,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        float threshold,
+        uint32_t vertexCache,
+        OPTOVERDRAW_FLAGS flags) noexcept
+    {
+        if (!indices || !nFaces || !positions || !nVerts || !faceRemap)
+            return E_INVALIDARG;
+
+        if (!vertexCache || !(threshold >= 1.f))
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            if (indices[j] != index_t(-1) && indices[j] >= nVerts)
+                return E_UNEXPECTED;
+        }
+
+        std::unique_ptr<uint64_t[]> timestamps(new (std::nothrow) uint64_t[nVerts]);
+        std::unique_ptr<cluster_key[]> clusters(new (std::nothrow) cluster_key[nFaces]);
+        if (!timestamps || !clusters)
+            return E_OUTOFMEMORY;
+
+        memset(timestamps.get(), 0, sizeof(uint64_t) * nVerts);
+
+        fifo_cache<index_t> cache(timestamps.get(), vertexCache);
+
+        // Clusters never cross attribute boundaries
+        uint32_t faceBegin = 0;
+        uint32_t* dest = faceRemap;
+        while (faceBegin < nFaces)
+        {
+            uint32_t faceEnd = faceBegin + 1;
+            if (attributes)
+            {
+                while (faceEnd < nFaces && attributes[faceEnd] == attributes[faceBegin])
+                    ++faceEnd;
+            }
+            else
+            {
+                faceEnd = static_cast<uint32_t>(nFaces);
+            }
+
+            const size_t nClusters = GenerateClusters<index_t>(indices, faceBegin, faceEnd, cache, threshold, clusters.get());
+
+            SortClusters<index_t>(indices, positions, clusters.get(), nClusters, flags);
+
+            for (size_t c = 0; c < nClusters; ++c)
+            {
+                for (uint32_t face = clusters[c].start; face < clusters[c].end; ++face)
+                {
+                    *dest++ = face;
+                }
+            }
+
+            faceBegin = faceEnd;
+        }
+
+        assert(dest == faceRemap + nFaces);
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeOverdraw(
+    const uint16_t* indices,
+    size_t nFaces,
+    const XMFLOAT3* positions,
+    size_t nVerts,
+    const uint32_t* attributes,
+    uint32_t* faceRemap,
+    float threshold,
+    uint32_t vertexCache,
+    OPTOVERDRAW_FLAGS flags) noexcept
+{
+    return OptimizeOverdrawImpl<uint16_t>(indices, nFaces, positions, nVerts, attributes, faceRemap, threshold, vertexCache, flags);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeOverdraw(
+    const uint32_t* indices,
+    size_t nFaces,
+    const XMFLOAT3* positions,
+    size_t nVerts,
+    const uint32_t* attributes,
+    uint32_t* faceRemap,
+    float threshold,
+    uint32_t vertexCache,
+    OPTOVERDRAW_FLAGS flags) noexcept
+{
+    return OptimizeOverdrawImpl<uint32_t>(indices, nFaces, positions, nVerts, attributes, faceRemap, threshold, vertexCache, flags);
+}
@@ -27,7 +27,8 @@ namespace
             mFaceOffset(0),
             mFaceCount(0),
             mMaxSubset(0),
-            mTotalFaces(0)
+            mTotalFaces(0),
+            mNeighbors(nullptr)
         {}
 
         HRESULT initialize(
@@ -167,6 +168,27 @@ namespace
             if (!mListElements)
                 return E_OUTOFMEMORY;
 
+            mNeighbors = mPhysicalNeighbors.get();
+
+            return S_OK;
+        }
+
+        // Shares the adjacency of an initialized instance, with separate per-subset state
+        HRESULT initialize(const mesh_status& shared) noexcept
+        {
+            if (!shared.mNeighbors || !shared.mMaxSubset)
+                return E_UNEXPECTED;
+
+            mListElements.reset(new (std::nothrow) listElement[shared.mMaxSubset]);
+            if (!mListElements)
+                return E_OUTOFMEMORY;
+
+            mFaceOffset = 0;
+            mFaceCount = 0;
+            mMaxSubset = shared.mMaxSubset;
+            mTotalFaces = shared.mTotalFaces;
+            mNeighbors = shared.mNeighbors;
+
             return S_OK;
         }
 
@@ -219,12 +241,12 @@ namespace
 
                 for (uint32_t n = 0; n < 3; ++n)
                 {
-                    if (mPhysicalNeighbors[face].neighbors[n] != UNUSED32)
+                    if (mNeighbors[face].neighbors[n] != UNUSED32)
                     {
                         unprocessed += 1;
 
-                        assert(mPhysicalNeighbors[face].neighbors[n] >= mFaceOffset);
-                        assert(mPhysicalNeighbors[face].neighbors[n] < faceMax);
+                        assert(mNeighbors[face].neighbors[n] >= mFaceOffset);
+                        assert(mNeighbors[face].neighbors[n] < faceMax);
                     }
                 }
 
@@ -277,7 +299,7 @@ namespace
 
             for (uint32_t n = 0; n < 3; ++n)
             {
-                const uint32_t neighbor = mPhysicalNeighbors[face].neighbors[n];
+                const uint32_t neighbor = mNeighbors[face].neighbors[n];
                 if ((neighbor != UNUSED32) && !isprocessed(neighbor))
                 {
                     decrement(neighbor);
@@ -296,7 +318,7 @@ namespace
 
             for (uint32_t n = 0; n < 3; ++n)
             {
-                const uint32_t neighbor = mPhysicalNeighbors[face].neighbors[n];
+                const uint32_t neighbor = mNeighbors[face].neighbors[n];
 
                 if ((neighbor == UNUSED32) || isprocessed(neighbor))
                     continue;
@@ -308,7 +330,7 @@ namespace
 
                 for (uint32_t nt = 0; nt < 3; ++nt)
                 {
-                    const uint32_t neighborTemp = mPhysicalNeighbors[neighbor].neighbors[nt];
+                    const uint32_t neighborTemp = mNeighbors[neighbor].neighbors[nt];
 
                     if ((neighborTemp == UNUSED32) || isprocessed(neighborTemp))
                         continue;
@@ -343,13 +365,13 @@ namespace
             assert(n < 3);
             _Analysis_assume_(face < mTotalFaces);
             _Analysis_assume_(n < 3);
-            return mPhysicalNeighbors[face].neighbors[n];
+            return mNeighbors[face].neighbors[n];
         }
 
         const uint32_t* get_neighborsPtr(uint32_t face) const noexcept
         {
             assert(face < mTotalFaces);
-            return &mPhysicalNeighbors[face].neighbors[0];
+            return &mNeighbors[face].neighbors[0];
         }
 
     private:
@@ -444,6 +466,7 @@ namespace
         size_t                          mTotalFaces;
         std::unique_ptr<listElement[]>  mListElements;
         std::unique_ptr<neighborInfo[]> mPhysicalNeighbors;
+        const neighborInfo*             mNeighbors;
     };
 
 
@@ -518,67 +541,277 @@ namespace
     };
 
 
+    //---------------------------------------------------------------------------------
+    // Attribute subsets are independent and write disjoint ranges of faceRemapInverse,
+    // so each thread works on its own subset status sharing the read-only adjacency
+    //---------------------------------------------------------------------------------
+    template<class index_t, class Func>
+    HRESULT ForEachSubset(
+        const mesh_status<index_t>& shared,
+        const std::vector<std::pair<size_t, size_t>>& subsets,
+        uint32_t vertexCache,
+        Func&& process)
+    {
+        std::unique_ptr<HRESULT[]> results(new (std::nothrow) HRESULT[subsets.size()]);
+        if (!results)
+            return E_OUTOFMEMORY;
+
+        const int count = static_cast<int>(subsets.size());
+
+    #ifdef _OPENMP
+    #pragma omp parallel if (count > 1)
+    #endif
+        {
+            mesh_status<index_t> status;
+            sim_vcache vcache;
+
+            HRESULT hr = status.initialize(shared);
+            if (SUCCEEDED(hr) && vertexCache)
+            {
+                hr = vcache.initialize(vertexCache);
+            }
+
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+        #endif
+            for (int j = 0; j < count; ++j)
+            {
+                results[size_t(j)] = (FAILED(hr)) ? hr : process(status, vcache, subsets[size_t(j)]);
+            }
+        }
+
+        for (size_t j = 0; j < subsets.size(); ++j)
+        {
+            if (FAILED(results[j]))
+                return results[j];
+        }
+
+        return S_OK;
+    }
+
+
     //---------------------------------------------------------------------------------
     template<class index_t>
-    HRESULT StripReorderImpl(
+    HRESULT StripReorderSubset(
+        mesh_status<index_t>& status,
         _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
-        _In_reads_(nFaces * 3) const uint32_t* adjacency,
-        _In_reads_opt_(nFaces) const uint32_t* attributes,
-        _Out_writes_(nFaces) uint32_t* faceRemap)
+        const std::pair<size_t, size_t>& subset,
+        _Inout_updates_all_(nFaces) uint32_t* faceRemapInverse) noexcept
     {
-        auto subsets = ComputeSubsets(attributes, nFaces);
-        if (subsets.empty())
-            return E_UNEXPECTED;
-
-        mesh_status<index_t> status;
-        HRESULT hr = status.initialize(indices, nFaces, nVerts, adjacency, subsets);
+        HRESULT hr = status.setSubset(indices, nFaces, nVerts, subset.first, subset.second);
         if (FAILED(hr))
             return hr;
 
-        std::unique_ptr<uint32_t[]> faceRemapInverse(new (std::nothrow) uint32_t[nFaces]);
-        if (!faceRemapInverse)
-            return E_OUTOFMEMORY;
-
-        memset(faceRemapInverse.get(), 0xff, sizeof(uint32_t) * nFaces);
+        uint32_t curface = 0;
 
-        for (const auto& it : subsets)
+        for (;;)
         {
-            hr = status.setSubset(indices, nFaces, nVerts, it.first, it.second);
-            if (FAILED(hr))
-                return hr;
+            uint32_t face = status.find_initial();
+            if (face == UNUSED32)
+                break;
+
+            status.mark(face);
 
-            uint32_t curface = 0;
+            uint32_t next = status.find_next(face);
 
             for (;;)
             {
-                uint32_t face = status.find_initial();
-                if (face == UNUSED32)
+                assert(face != UNUSED32);
+                faceRemapInverse[face] = uint32_t(curface + subset.first);
+                curface += 1;
+
+                // if at end of strip, break out
+                if (next >= 3)
                     break;
 
+                face = status.get_neighbors(face, next);
+                assert(face != UNUSED32);
+
                 status.mark(face);
 
-                uint32_t next = status.find_next(face);
+                next = status.find_next(face);
+            }
+        }
+
+        return S_OK;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT VertexCacheStripReorderSubset(
+        mesh_status<index_t>& status,
+        sim_vcache& vcache,
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        const std::pair<size_t, size_t>& subset,
+        uint32_t desired,
+        _Inout_updates_all_(nFaces) uint32_t* faceRemapInverse) noexcept
+    {
+        HRESULT hr = status.setSubset(indices, nFaces, nVerts, subset.first, subset.second);
+        if (FAILED(hr))
+            return hr;
+
+        vcache.clear();
+
+        uint32_t locnext = 0;
+        facecorner_t nextCorner(UNUSED32, UNUSED32);
+        facecorner_t curCorner(UNUSED32, UNUSED32);
+
+        uint32_t curface = 0;
+
+        for (;;)
+        {
+            assert(nextCorner.first == UNUSED32);
+
+            curCorner.first = status.find_initial();
+            if (curCorner.first == UNUSED32)
+                break;
+
+            const uint32_t n0 = status.get_neighbors(curCorner.first, 0);
+            if ((n0 != UNUSED32) && !status.isprocessed(n0))
+            {
+                curCorner.second = 1;
+            }
+            else
+            {
+                const uint32_t n1 = status.get_neighbors(curCorner.first, 1);
+                if ((n1 != UNUSED32) && !status.isprocessed(n1))
+                {
+                    curCorner.second = 2;
+                }
+                else
+                {
+                    curCorner.second = 0;
+                }
+            }
+
+            bool striprestart = false;
+            for (;;)
+            {
+                assert(curCorner.first != UNUSED32);
+                assert(!status.isprocessed(curCorner.first));
+
+                // Decision: either add a ring of faces or restart strip
+                if (nextCorner.first != UNUSED32)
+                {
+                    uint32_t nf = 0;
+                    for (facecorner_t temp = curCorner; ; )
+                    {
+                        const facecorner_t next = counterclockwise_corner<index_t>(temp, status);
+                        if ((next.first == UNUSED32) || status.isprocessed(next.first))
+                            break;
+                        ++nf;
+                        temp = next;
+                    }
+
+                    if (locnext + nf > desired)
+                    {
+                        // restart
+                        if (!status.isprocessed(nextCorner.first))
+                        {
+                            curCorner = nextCorner;
+                        }
+
+                        nextCorner.first = UNUSED32;
+                    }
+                }
 
                 for (;;)
                 {
-                    assert(face != UNUSED32);
-                    faceRemapInverse[face] = uint32_t(curface + it.first);
+                    assert(curCorner.first != UNUSED32);
+                    status.mark(curCorner.first);
+
+                    faceRemapInverse[curCorner.first] = uint32_t(curface + subset.first);
                     curface += 1;
 
-                    // if at end of strip, break out
-                    if (next >= 3)
-                        break;
+                    assert(indices[curCorner.first * 3] != index_t(-1));
+                    if (!vcache.access(indices[curCorner.first * 3]))
+                        locnext += 1;
+
+                    assert(indices[curCorner.first * 3 + 1] != index_t(-1));
+                    if (!vcache.access(indices[curCorner.first * 3 + 1]))
+                        locnext += 1;
+
+                    assert(indices[curCorner.first * 3 + 2] != index_t(-1));
+                    if (!vcache.access(indices[curCorner.first * 3 + 2]))
+                        locnext += 1;
 
-                    face = status.get_neighbors(face, next);
-                    assert(face != UNUSED32);
+                    const facecorner_t intCorner = counterclockwise_corner<index_t>(curCorner, status);
+                    const bool interiornei = (intCorner.first != UNUSED32) && !status.isprocessed(intCorner.first);
 
-                    status.mark(face);
+                    const facecorner_t extCorner = counterclockwise_corner<index_t>(facecorner_t(curCorner.first, (curCorner.second + 2) % 3), status);
+                    const bool exteriornei = (extCorner.first != UNUSED32) && !status.isprocessed(extCorner.first);
 
-                    next = status.find_next(face);
+                    if (interiornei)
+                    {
+                        if (exteriornei)
+                        {
+                            if (nextCorner.first == UNUSED32)
+                            {
+                                nextCorner = extCorner;
+                                locnext = 0;
+                            }
+                        }
+                        curCorner = intCorner;
+                    }
+                    else if (exteriornei)
+                    {
+                        curCorner = extCorner;
+                        break;
+                    }
+                    else
+                    {
+                        curCorner = nextCorner;
+                        nextCorner.first = UNUSED32;
+
+                        if ((curCorner.first == UNUSED32) || status.isprocessed(curCorner.first))
+                        {
+                            striprestart = true;
+                            break;
+                        }
+                    }
                 }
+
+                if (striprestart)
+                    break;
             }
         }
 
+        return S_OK;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT StripReorderImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap)
+    {
+        auto subsets = ComputeSubsets(attributes, nFaces);
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        mesh_status<index_t> status;
+        HRESULT hr = status.initialize(indices, nFaces, nVerts, adjacency, subsets);
+        if (FAILED(hr))
+            return hr;
+
+        std::unique_ptr<uint32_t[]> faceRemapInverse(new (std::nothrow) uint32_t[nFaces]);
+        if (!faceRemapInverse)
+            return E_OUTOFMEMORY;
+
+        memset(faceRemapInverse.get(), 0xff, sizeof(uint32_t) * nFaces);
+
+        hr = ForEachSubset<index_t>(status, subsets, 0,
+            [&](mesh_status<index_t>& local, sim_vcache&, const std::pair<size_t, size_t>& subset) noexcept -> HRESULT
+            {
+                return StripReorderSubset<index_t>(local, indices, nFaces, nVerts, subset, faceRemapInverse.get());
+            });
+        if (FAILED(hr))
+            return hr;
+
         // inverse remap
         memset(faceRemap, 0xff, sizeof(uint32_t) * nFaces);
 
@@ -613,11 +846,6 @@ namespace
         if (FAILED(hr))
             return hr;
 
-        sim_vcache vcache;
-        hr = vcache.initialize(vertexCache);
-        if (FAILED(hr))
-            return hr;
-
         std::unique_ptr<uint32_t[]> faceRemapInverse(new (std::nothrow) uint32_t[nFaces]);
         if (!faceRemapInverse)
             return E_OUTOFMEMORY;
@@ -627,148 +855,222 @@ namespace
         assert(vertexCache >= restart);
         const uint32_t desired = vertexCache - restart;
 
-        for (const auto& it : subsets)
+        hr = ForEachSubset<index_t>(status, subsets, vertexCache,
+            [&](mesh_status<index_t>& local, sim_vcache& localCache, const std::pair<size_t, size_t>& subset) noexcept -> HRESULT
+            {
+                return VertexCacheStripReorderSubset<index_t>(local, localCache, indices, nFaces, nVerts, subset, desired, faceRemapInverse.get());
+            });
+        if (FAILED(hr))
+            return hr;
+
+        // inverse remap
+        memset(faceRemap, 0xff, sizeof(uint32_t) * nFaces);
+
+        for (size_t j = 0; j < nFaces; ++j)
         {
-            hr = status.setSubset(indices, nFaces, nVerts, it.first, it.second);
-            if (FAILED(hr))
-                return hr;
+            uint32_t f = faceRemapInverse[j];
+            if (f < nFaces)
+            {
+                faceRemap[f] = static_cast<uint32_t>(j);
+            }
+        }
 
-            vcache.clear();
+        return S_OK;
+    }
 
-            uint32_t locnext = 0;
-            facecorner_t nextCorner(UNUSED32, UNUSED32);
-            facecorner_t curCorner(UNUSED32, UNUSED32);
 
-            uint32_t curface = 0;
+    //---------------------------------------------------------------------------------
+    // Builds triangle strips by walking neighbors across the strip's trailing edge,
+    // restarting next to the previous strip so adjacent strips share cached vertices
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    bool IsFaceRotation(_In_reads_(3) const index_t* face, index_t a, index_t b, index_t c) noexcept
+    {
+        return (face[0] == a && face[1] == b && face[2] == c)
+            || (face[1] == a && face[2] == b && face[0] == c)
+            || (face[2] == a && face[0] == b && face[1] == c);
+    }
 
-            for (;;)
-            {
-                assert(nextCorner.first == UNUSED32);
+    template<class index_t>
+    HRESULT StripifySubset(
+        mesh_status<index_t>& status,
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        const std::pair<size_t, size_t>& subset,
+        size_t maxStripFaces,
+        std::vector<uint32_t>& prevStrip,
+        std::vector<uint32_t>& curStrip,
+        std::vector<index_t>& stripIndices)
+    {
+        HRESULT hr = status.setSubset(indices, nFaces, nVerts, subset.first, subset.second);
+        if (FAILED(hr))
+            return hr;
 
-                curCorner.first = status.find_initial();
-                if (curCorner.first == UNUSED32)
-                    break;
+        prevStrip.clear();
 
-                const uint32_t n0 = status.get_neighbors(curCorner.first, 0);
-                if ((n0 != UNUSED32) && !status.isprocessed(n0))
-                {
-                    curCorner.second = 1;
-                }
-                else
+        const size_t subsetStart = stripIndices.size();
+
+        for (;;)
+        {
+            // Prefer starting alongside the previous strip
+            uint32_t face = UNUSED32;
+            for (const uint32_t it : prevStrip)
+            {
+                for (uint32_t n = 0; n < 3; ++n)
                 {
-                    const uint32_t n1 = status.get_neighbors(curCorner.first, 1);
-                    if ((n1 != UNUSED32) && !status.isprocessed(n1))
-                    {
-                        curCorner.second = 2;
-                    }
-                    else
+                    const uint32_t neighbor = status.get_neighbors(it, n);
+                    if ((neighbor != UNUSED32) && !status.isprocessed(neighbor))
                     {
-                        curCorner.second = 0;
+                        face = neighbor;
+                        break;
                     }
                 }
 
-                bool striprestart = false;
-                for (;;)
-                {
-                    assert(curCorner.first != UNUSED32);
-                    assert(!status.isprocessed(curCorner.first));
+                if (face != UNUSED32)
+                    break;
+            }
 
-                    // Decision: either add a ring of faces or restart strip
-                    if (nextCorner.first != UNUSED32)
-                    {
-                        uint32_t nf = 0;
-                        for (facecorner_t temp = curCorner; ; )
-                        {
-                            const facecorner_t next = counterclockwise_corner<index_t>(temp, status);
-                            if ((next.first == UNUSED32) || status.isprocessed(next.first))
-                                break;
-                            ++nf;
-                            temp = next;
-                        }
+            if (face == UNUSED32)
+            {
+                face = status.find_initial();
+                if (face == UNUSED32)
+                    break;
+            }
 
-                        if (locnext + nf > desired)
-                        {
-                            // restart
-                            if (!status.isprocessed(nextCorner.first))
-                            {
-                                curCorner = nextCorner;
-                            }
+            status.mark(face);
 
-                            nextCorner.first = UNUSED32;
-                        }
-                    }
+            const index_t* tri = &indices[size_t(face) * 3];
+            if (tri[0] == tri[1] || tri[0] == tri[2] || tri[1] == tri[2])
+            {
+                // Degenerate faces have no area, so they are dropped
+                continue;
+            }
 
-                    for (;;)
-                    {
-                        assert(curCorner.first != UNUSED32);
-                        status.mark(curCorner.first);
+            if (stripIndices.size() > subsetStart)
+            {
+                stripIndices.push_back(index_t(-1));
+            }
 
-                        faceRemapInverse[curCorner.first] = uint32_t(curface + it.first);
-                        curface += 1;
+            // Rotate the first face so the trailing edge leads to the best neighbor
+            const uint32_t next = status.find_next(face);
+            const uint32_t r = (next < 3) ? ((next + 2) % 3) : 0;
 
-                        assert(indices[curCorner.first * 3] != index_t(-1));
-                        if (!vcache.access(indices[curCorner.first * 3]))
-                            locnext += 1;
+            stripIndices.push_back(tri[r]);
+            stripIndices.push_back(tri[(r + 1) % 3]);
+            stripIndices.push_back(tri[(r + 2) % 3]);
 
-                        assert(indices[curCorner.first * 3 + 1] != index_t(-1));
-                        if (!vcache.access(indices[curCorner.first * 3 + 1]))
-                            locnext += 1;
+            curStrip.clear();
+            curStrip.push_back(face);
 
-                        assert(indices[curCorner.first * 3 + 2] != index_t(-1));
-                        if (!vcache.access(indices[curCorner.first * 3 + 2]))
-                            locnext += 1;
+            uint32_t edge = next;
+            while (edge < 3 && curStrip.size() < maxStripFaces)
+            {
+                const uint32_t neighbor = status.get_neighbors(face, edge);
+                if ((neighbor == UNUSED32) || status.isprocessed(neighbor))
+                    break;
 
-                        const facecorner_t intCorner = counterclockwise_corner<index_t>(curCorner, status);
-                        const bool interiornei = (intCorner.first != UNUSED32) && !status.isprocessed(intCorner.first);
+                const index_t x = stripIndices[stripIndices.size() - 2];
+                const index_t y = stripIndices[stripIndices.size() - 1];
 
-                        const facecorner_t extCorner = counterclockwise_corner<index_t>(facecorner_t(curCorner.first, (curCorner.second + 2) % 3), status);
-                        const bool exteriornei = (extCorner.first != UNUSED32) && !status.isprocessed(extCorner.first);
+                const index_t* ntri = &indices[size_t(neighbor) * 3];
+                index_t z = index_t(-1);
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    if (ntri[k] != x && ntri[k] != y)
+                    {
+                        z = ntri[k];
+                        break;
+                    }
+                }
 
-                        if (interiornei)
-                        {
-                            if (exteriornei)
-                            {
-                                if (nextCorner.first == UNUSED32)
-                                {
-                                    nextCorner = extCorner;
-                                    locnext = 0;
-                                }
-                            }
-                            curCorner = intCorner;
-                        }
-                        else if (exteriornei)
-                        {
-                            curCorner = extCorner;
-                            break;
-                        }
-                        else
-                        {
-                            curCorner = nextCorner;
-                            nextCorner.first = UNUSED32;
+                // Odd triangles in a strip have their first two vertices swapped
+                const bool odd = (curStrip.size() & 1) != 0;
+                if (z == index_t(-1) || !IsFaceRotation<index_t>(ntri, odd ? y : x, odd ? x : y, z))
+                    break;
 
-                            if ((curCorner.first == UNUSED32) || status.isprocessed(curCorner.first))
-                            {
-                                striprestart = true;
-                                break;
-                            }
-                        }
-                    }
+                status.mark(neighbor);
+                stripIndices.push_back(z);
+                curStrip.push_back(neighbor);
+                face = neighbor;
 
-                    if (striprestart)
+                // The trailing edge of the strip is now (y, z)
+                edge = 3;
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    const index_t p1 = ntri[k];
+                    const index_t p2 = ntri[(k + 1) % 3];
+                    if ((p1 == y && p2 == z) || (p1 == z && p2 == y))
+                    {
+                        edge = k;
                         break;
+                    }
                 }
             }
+
+            std::swap(prevStrip, curStrip);
         }
 
-        // inverse remap
-        memset(faceRemap, 0xff, sizeof(uint32_t) * nFaces);
+        return S_OK;
+    }
 
-        for (size_t j = 0; j < nFaces; ++j)
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT GenerateStripsImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        std::vector<index_t>& stripIndices,
+        _Out_opt_ std::vector<std::pair<size_t, size_t>>* stripSubsets,
+        uint32_t vertexCache)
+    {
+        if (!indices || !nFaces || !nVerts || !adjacency)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        stripIndices.clear();
+        if (stripSubsets)
         {
-            uint32_t f = faceRemapInverse[j];
-            if (f < nFaces)
+            stripSubsets->clear();
+        }
+
+        auto subsets = ComputeSubsets(attributes, nFaces);
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        mesh_status<index_t> status;
+        HRESULT hr = status.initialize(indices, nFaces, nVerts, adjacency, subsets);
+        if (FAILED(hr))
+            return hr;
+
+        // A strip of n faces uses n + 2 vertices which the next strip alongside it reuses, so strips
+        // are kept short enough for those vertices to still be in the cache (with a little slack)
+        size_t maxStripFaces = SIZE_MAX;
+        if (vertexCache != OPTFACES_V_STRIPORDER)
+        {
+            maxStripFaces = (vertexCache > 4) ? (vertexCache - 4) : 1;
+        }
+
+        stripIndices.reserve(nFaces * 3);
+
+        std::vector<uint32_t> prevStrip;
+        std::vector<uint32_t> curStrip;
+
+        for (const auto& it : subsets)
+        {
+            const size_t offset = stripIndices.size();
+
+            hr = StripifySubset<index_t>(status, indices, nFaces, nVerts, it, maxStripFaces, prevStrip, curStrip, stripIndices);
+            if (FAILED(hr))
+                return hr;
+
+            if (stripSubsets)
             {
-                faceRemap[f] = static_cast<uint32_t>(j);
+                stripSubsets->emplace_back(offset, stripIndices.size() - offset);
             }
         }
 
@@ -899,3 +1201,33 @@ HRESULT DirectX::OptimizeFacesEx(
         return VertexCacheStripReorderImpl<uint32_t>(indices, nFaces, nVerts, adjacency, attributes, faceRemap, vertexCache, restart);
     }
 }
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::GenerateStrips(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    const uint32_t* attributes,
+    std::vector<uint16_t>& stripIndices,
+    std::vector<std::pair<size_t, size_t>>* stripSubsets,
+    uint32_t vertexCache)
+{
+    return GenerateStripsImpl<uint16_t>(indices, nFaces, nVerts, adjacency, attributes, stripIndices, stripSubsets, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateStrips(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    const uint32_t* attributes,
+    std::vector<uint32_t>& stripIndices,
+    std::vector<std::pair<size_t, size_t>>* stripSubsets,
+    uint32_t vertexCache)
+{
+    return GenerateStripsImpl<uint32_t>(indices, nFaces, nVerts, adjacency, attributes, stripIndices, stripSubsets, vertexCache);
+}
@@ -0,0 +1,357 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshOptimizeTipsify.cpp
+//
+// DirectX Mesh Geometry Library - Mesh optimization
+//
+// Sander, Nehab, and Barczak "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// https://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Per-vertex state is sized to the whole vertex buffer and shared by all subsets,
+    // so only the vertices referenced by a subset are touched when processing it
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    class tipsify_state
+    {
+    public:
+        tipsify_state() noexcept :
+            mTime(0),
+            mCacheSize(0),
+            mFaceCount(0)
+        {}
+
+        HRESULT initialize(size_t nFaces, size_t nVerts, uint32_t cacheSize) noexcept
+        {
+            mLive.reset(new (std::nothrow) uint32_t[nVerts]);
+            mAdjStart.reset(new (std::nothrow) uint32_t[nVerts]);
+            mAdjEnd.reset(new (std::nothrow) uint32_t[nVerts]);
+            mCacheTime.reset(new (std::nothrow) uint64_t[nVerts]);
+            mAdjList.reset(new (std::nothrow) uint32_t[nFaces * 3]);
+            mDeadEnd.reset(new (std::nothrow) index_t[nFaces * 3]);
+            mEmitted.reset(new (std::nothrow) uint8_t[nFaces]);
+            if (!mLive || !mAdjStart || !mAdjEnd || !mCacheTime || !mAdjList || !mDeadEnd || !mEmitted)
+                return E_OUTOFMEMORY;
+
+            memset(mLive.get(), 0, sizeof(uint32_t) * nVerts);
+            memset(mAdjStart.get(), 0xff, sizeof(uint32_t) * nVerts);
+            memset(mCacheTime.get(), 0, sizeof(uint64_t) * nVerts);
+
+            mTime = uint64_t(cacheSize) + 1;
+            mCacheSize = cacheSize;
+            mFaceCount = nFaces;
+
+            return S_OK;
+        }
+
+        // Reorders the faces [faceOffset, faceOffset + faceCount) writing the result to faceRemap
+        void optimize(
+            _In_ const index_t* indices,
+            size_t faceOffset,
+            size_t faceCount,
+            _Out_writes_(faceCount) uint32_t* faceRemap) noexcept
+        {
+            assert((faceOffset + faceCount) <= mFaceCount);
+
+            const index_t* subsetIndices = indices + faceOffset * 3;
+            const size_t indexCount = faceCount * 3;
+
+            // Build the vertex to face adjacency for the subset
+            for (size_t j = 0; j < indexCount; j += 3)
+            {
+                if (!isvalid(&subsetIndices[j]))
+                    continue;
+
+                mLive[subsetIndices[j]] += 1;
+                mLive[subsetIndices[j + 1]] += 1;
+                mLive[subsetIndices[j + 2]] += 1;
+            }
+
+            uint32_t adjOffset = 0;
+            for (size_t j = 0; j < indexCount; ++j)
+            {
+                const index_t v = subsetIndices[j];
+                if (v == index_t(-1) || mAdjStart[v] != UNUSED32)
+                    continue;
+
+                mAdjStart[v] = mAdjEnd[v] = adjOffset;
+                adjOffset += mLive[v];
+            }
+
+            for (size_t j = 0; j < indexCount; j += 3)
+            {
+                if (!isvalid(&subsetIndices[j]))
+                    continue;
+
+                const auto face = static_cast<uint32_t>(j / 3);
+                mAdjList[mAdjEnd[subsetIndices[j]]++] = face;
+                mAdjList[mAdjEnd[subsetIndices[j + 1]]++] = face;
+                mAdjList[mAdjEnd[subsetIndices[j + 2]]++] = face;
+            }
+
+            memset(mEmitted.get(), 0, sizeof(uint8_t) * faceCount);
+
+            // Start each subset with an empty cache
+            mTime += uint64_t(mCacheSize) + 1;
+
+            size_t curFace = 0;
+            size_t deadEndSize = 0;
+            size_t cursor = 0;
+
+            uint32_t fan = nextlive(subsetIndices, indexCount, cursor);
+            while (fan != UNUSED32)
+            {
+                // Emit every remaining face around the fanning vertex
+                const size_t candidates = deadEndSize;
+                for (uint32_t j = mAdjStart[fan]; j < mAdjEnd[fan]; ++j)
+                {
+                    const uint32_t face = mAdjList[j];
+                    if (mEmitted[face])
+                        continue;
+
+                    mEmitted[face] = 1;
+                    faceRemap[curFace++] = static_cast<uint32_t>(face + faceOffset);
+
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const index_t v = subsetIndices[size_t(face) * 3 + k];
+                        mDeadEnd[deadEndSize++] = v;
+                        mLive[v] -= 1;
+
+                        if ((mTime - mCacheTime[v]) > mCacheSize)
+                        {
+                            mCacheTime[v] = mTime++;
+                        }
+                    }
+                }
+
+                // Prefer the live vertex that will still be in the cache after fanning it
+                fan = UNUSED32;
+                int64_t bestPriority = -1;
+                for (size_t j = candidates; j < deadEndSize; ++j)
+                {
+                    const index_t v = mDeadEnd[j];
+                    if (!mLive[v])
+                        continue;
+
+                    int64_t priority = 0;
+                    const uint64_t age = mTime - mCacheTime[v];
+                    if ((age + 2 * uint64_t(mLive[v])) <= mCacheSize)
+                    {
+                        priority = int64_t(age);
+                    }
+
+                    if (priority > bestPriority)
+                    {
+                        bestPriority = priority;
+                        fan = v;
+                    }
+                }
+
+                if (fan == UNUSED32)
+                {
+                    // Dead end: back up through recently used vertices, then fall back to input order
+                    while (deadEndSize > 0)
+                    {
+                        const index_t v = mDeadEnd[--deadEndSize];
+                        if (mLive[v] > 0)
+                        {
+                            fan = v;
+                            break;
+                        }
+                    }
+
+                    if (fan == UNUSED32)
+                    {
+                        fan = nextlive(subsetIndices, indexCount, cursor);
+                    }
+                }
+            }
+
+            // Unused faces are dropped to the end
+            for (; curFace < faceCount; ++curFace)
+            {
+                faceRemap[curFace] = UNUSED32;
+            }
+
+            // Reset the per-vertex state touched by this subset
+            for (size_t j = 0; j < indexCount; ++j)
+            {
+                const index_t v = subsetIndices[j];
+                if (v != index_t(-1))
+                {
+                    assert(mLive[v] == 0);
+                    mAdjStart[v] = UNUSED32;
+                }
+            }
+        }
+
+    private:
+        static bool isvalid(_In_reads_(3) const index_t* face) noexcept
+        {
+            return face[0] != index_t(-1) && face[1] != index_t(-1) && face[2] != index_t(-1);
+        }
+
+        uint32_t nextlive(_In_reads_(indexCount) const index_t* indices, size_t indexCount, size_t& cursor) const noexcept
+        {
+            for (; cursor < indexCount; ++cursor)
+            {
+                const index_t v = indices[cursor];
+                if (v != index_t(-1) && mLive[v] > 0)
+                    return v;
+            }
+
+            return UNUSED32;
+        }
+
+        std::unique_ptr<uint32_t[]> mLive;
+        std::unique_ptr<uint32_t[]> mAdjStart;
+        std::unique_ptr<uint32_t[]> mAdjEnd;
+        std::unique_ptr<uint64_t[]> mCacheTime;
+        std::unique_ptr<uint32_t[]> mAdjList;
+        std::unique_ptr<index_t[]>  mDeadEnd;
+        std::unique_ptr<uint8_t[]>  mEmitted;
+        uint64_t                    mTime;
+        uint32_t                    mCacheSize;
+        size_t                      mFaceCount;
+    };
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeFacesTipsifyImpl(
+        _In_reads_(nFaces * 3) const index_t* indices,
+        size_t nFaces,
+        size_t nVerts,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        uint32_t vertexCache)
+    {
+        if (!vertexCache)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            if (indices[j] != index_t(-1) && indices[j] >= nVerts)
+                return E_UNEXPECTED;
+        }
+
+        tipsify_state<index_t> state;
+        HRESULT hr = state.initialize(nFaces, nVerts, vertexCache);
+        if (FAILED(hr))
+            return hr;
+
+        if (!attributes)
+        {
+            state.optimize(indices, 0, nFaces, faceRemap);
+            return S_OK;
+        }
+
+        auto subsets = ComputeSubsets(attributes, nFaces);
+
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        for (const auto& it : subsets)
+        {
+            if (it.first >= nFaces)
+                return E_UNEXPECTED;
+
+            if ((uint64_t(it.first) + uint64_t(it.second)) > nFaces)
+                return E_UNEXPECTED;
+
+            state.optimize(indices, it.first, it.second, &faceRemap[it.first]);
+        }
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsify(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    uint32_t* faceRemap,
+    uint32_t vertexCache)
+{
+    if (!indices || !nFaces || !nVerts || !faceRemap)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return OptimizeFacesTipsifyImpl<uint16_t>(indices, nFaces, nVerts, nullptr, faceRemap, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsify(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    uint32_t* faceRemap,
+    uint32_t vertexCache)
+{
+    if (!indices || !nFaces || !nVerts || !faceRemap)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return OptimizeFacesTipsifyImpl<uint32_t>(indices, nFaces, nVerts, nullptr, faceRemap, vertexCache);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsifyEx(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* attributes,
+    uint32_t* faceRemap,
+    uint32_t vertexCache)
+{
+    if (!indices || !nFaces || !nVerts || !attributes || !faceRemap)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return OptimizeFacesTipsifyImpl<uint16_t>(indices, nFaces, nVerts, attributes, faceRemap, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsifyEx(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* attributes,
+    uint32_t* faceRemap,
+    uint32_t vertexCache)
+{
+    if (!indices || !nFaces || !nVerts || !attributes || !faceRemap)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return OptimizeFacesTipsifyImpl<uint32_t>(indices, nFaces, nVerts, attributes, faceRemap, vertexCache);
+}
@@ -158,6 +158,9 @@
 // HRESULT_FROM_WIN32(ERROR_INVALID_NAME)
 #define HRESULT_E_INVALID_NAME static_cast<HRESULT>(0x8007007BL)
 
+// HRESULT_FROM_WIN32(ERROR_INVALID_DATA)
+#define HRESULT_E_INVALID_DATA static_cast<HRESULT>(0x8007000DL)
+
 // E_BOUNDS
 #ifndef E_BOUNDS
 #define E_BOUNDS static_cast<HRESULT>(0x8000000BL)
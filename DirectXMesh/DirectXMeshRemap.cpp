@@ -17,6 +17,15 @@ namespace
 {
     constexpr size_t c_MaxStride = 2048;
 
+    // Number of faces or vertices each thread processes at a time in the parallel remaps
+    constexpr size_t c_BlockSize = 4096;
+
+    // Vertex soups are partitioned on the top bits of the vertex hash so each partition's
+    // table can be built by one thread
+    constexpr uint32_t c_HashPartitionBits = 8;
+    constexpr size_t c_HashPartitions = size_t(1) << c_HashPartitionBits;
+    constexpr size_t c_PartitionBlockSize = 65536;
+
 #if defined(__d3d11_h__) || defined(__d3d11_x_h__)
     static_assert(c_MaxStride == D3D11_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES, "D3D11 mismatch");
 #endif
@@ -25,6 +34,64 @@ namespace
     static_assert(c_MaxStride == D3D12_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES, "D3D12 mismatch");
 #endif
 
+    //---------------------------------------------------------------------------------
+    // Hashes the bytes of a vertex across all of its streams
+    //---------------------------------------------------------------------------------
+    inline uint32_t HashVertex(
+        _In_reads_(nStreams) const uint8_t* const* vbs,
+        _In_reads_(nStreams) const size_t* strides,
+        size_t nStreams,
+        size_t v) noexcept
+    {
+        uint32_t h = 0;
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            const size_t stride = strides[s];
+            const uint8_t* ptr = vbs[s] + v * stride;
+
+            size_t j = 0;
+            for (; j + sizeof(uint32_t) <= stride; j += sizeof(uint32_t))
+            {
+                uint32_t k;
+                memcpy(&k, ptr + j, sizeof(uint32_t));
+                k *= 0xCC9E2D51u;
+                k = (k << 15) | (k >> 17);
+                k *= 0x1B873593u;
+                h ^= k;
+                h = (h << 13) | (h >> 19);
+                h = h * 5 + 0xE6546B64u;
+            }
+            for (; j < stride; ++j)
+            {
+                h = (h ^ ptr[j]) * 0x01000193u;
+            }
+        }
+
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    inline bool EqualVertices(
+        _In_reads_(nStreams) const uint8_t* const* vbs,
+        _In_reads_(nStreams) const size_t* strides,
+        size_t nStreams,
+        size_t a,
+        size_t b) noexcept
+    {
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            const size_t stride = strides[s];
+            if (memcmp(vbs[s] + a * stride, vbs[s] + b * stride, stride) != 0)
+                return false;
+        }
+
+        return true;
+    }
+
     //---------------------------------------------------------------------------------
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -45,15 +112,30 @@ namespace
         assert((!adjin && !adjout) || ((adjin && adjout) && adjin != adjout));
         _Analysis_assume_((!adjin && !adjout) || ((adjin && adjout) && adjin != adjout));
 
+        // Validate up front so the copy can be split across threads
         for (size_t j = 0; j < nFaces; ++j)
         {
             const uint32_t src = faceRemap[j];
+            if (src != UNUSED32 && src >= nFaces)
+                return E_UNEXPECTED;
+        }
 
-            if (src == UNUSED32)
-                continue;
+        const int count = static_cast<int>((nFaces + c_BlockSize - 1) / c_BlockSize);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces);
 
-            if (src < nFaces)
+            for (size_t j = start; j < end; ++j)
             {
+                const uint32_t src = faceRemap[j];
+                if (src == UNUSED32)
+                    continue;
+
                 ibout[j * 3] = ibin[src * 3];
                 ibout[j * 3 + 1] = ibin[src * 3 + 1];
                 ibout[j * 3 + 2] = ibin[src * 3 + 2];
@@ -65,8 +147,6 @@ namespace
                     adjout[j * 3 + 2] = adjin[src * 3 + 2];
                 }
             }
-            else
-                return E_UNEXPECTED;
         }
 
         return S_OK;
@@ -278,26 +358,31 @@ namespace
 
 
     //---------------------------------------------------------------------------------
-    template<class index_t>
-    HRESULT FinalizeIBImpl(
-        _In_reads_(nFaces * 3) const index_t* ibin, size_t nFaces,
-        _In_reads_(nVerts) const uint32_t* vertexRemap, size_t nVerts,
-        _Out_writes_(nFaces * 3) index_t* ibout) noexcept
+    // Same permutation cycles as SwapVertices, but each swap is applied to every stream
+    //---------------------------------------------------------------------------------
+    HRESULT SwapVertexStreams(
+        _In_reads_(nStreams) void* const* vbs, _In_reads_(nStreams) const size_t* strides, size_t nStreams,
+        size_t nVerts, _In_reads_(nVerts) const uint32_t* vertexRemap) noexcept
     {
-        if (!ibin || !nFaces || !vertexRemap || !nVerts || !ibout)
+        if (!vbs || !strides || !nStreams || !nVerts || !vertexRemap)
             return E_INVALIDARG;
 
-        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
-            return HRESULT_E_ARITHMETIC_OVERFLOW;
+        size_t maxStride = 0;
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            if (!vbs[s] || !strides[s] || strides[s] > c_MaxStride)
+                return E_INVALIDARG;
 
-        if (nVerts >= index_t(-1))
-            return E_INVALIDARG;
+            maxStride = std::max(maxStride, strides[s]);
+        }
 
-        std::unique_ptr<uint32_t[]> vertexRemapInverse(new (std::nothrow) uint32_t[nVerts]);
-        if (!vertexRemapInverse)
+        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[((sizeof(bool) + sizeof(uint32_t)) * nVerts) + maxStride]);
+        if (!temp)
             return E_OUTOFMEMORY;
 
-        memset(vertexRemapInverse.get(), 0xff, sizeof(uint32_t) * nVerts);
+        auto vertexRemapInverse = reinterpret_cast<uint32_t*>(temp.get());
+
+        memset(vertexRemapInverse, 0xff, sizeof(uint32_t) * nVerts);
 
         for (uint32_t j = 0; j < nVerts; ++j)
         {
@@ -310,44 +395,70 @@ namespace
             }
         }
 
-        for (size_t j = 0; j < (nFaces * 3); ++j)
+        auto moved = reinterpret_cast<bool*>(temp.get() + sizeof(uint32_t) * nVerts);
+        memset(moved, 0, sizeof(bool) * nVerts);
+
+        auto vbtemp = temp.get() + ((sizeof(bool) + sizeof(uint32_t)) * nVerts);
+
+        for (size_t j = 0; j < nVerts; ++j)
         {
-            index_t i = ibin[j];
-            if (i == index_t(-1))
-            {
-                ibout[j] = index_t(-1);
+            if (moved[j])
                 continue;
-            }
 
-            if (i >= nVerts)
-                return E_UNEXPECTED;
+            uint32_t dest = vertexRemapInverse[j];
 
-            const uint32_t dest = vertexRemapInverse[i];
             if (dest == UNUSED32)
-            {
-                ibout[j] = i;
                 continue;
-            }
 
-            if (dest < nVerts)
+            if (dest >= nVerts)
+                return E_UNEXPECTED;
+
+            while (dest != j)
             {
-                ibout[j] = index_t(dest);
+                // Swap vertex in every stream
+                for (size_t s = 0; s < nStreams; ++s)
+                {
+                    const size_t stride = strides[s];
+                    auto ptr = static_cast<uint8_t*>(vbs[s]);
+
+                #ifdef _PREFAST_
+                #pragma prefast(push)
+                #pragma prefast(disable : 26019, "PREfast noise: Esp:1307")
+                #endif
+                    memcpy(vbtemp, ptr + dest*stride, stride);
+                    memcpy(ptr + dest*stride, ptr + j*stride, stride);
+                    memcpy(ptr + j*stride, vbtemp, stride);
+                #ifdef _PREFAST_
+                #pragma prefast(pop)
+                #endif
+                }
+
+                moved[dest] = true;
+
+                dest = vertexRemapInverse[dest];
+
+                if (dest == UNUSED32 || moved[dest])
+                    break;
+
+                if (dest >= nVerts)
+                    return E_FAIL;
             }
-            else
-                return E_FAIL;
         }
 
         return S_OK;
     }
 
 
+    //---------------------------------------------------------------------------------
+    // ibin and ibout may be the same buffer, as each index is remapped independently
     //---------------------------------------------------------------------------------
     template<class index_t>
     HRESULT FinalizeIBImpl(
-        _Inout_updates_all_(nFaces * 3) index_t* ib, size_t nFaces,
-        _In_reads_(nVerts) const uint32_t* vertexRemap, size_t nVerts) noexcept
+        _In_reads_(nFaces * 3) const index_t* ibin, size_t nFaces,
+        _In_reads_(nVerts) const uint32_t* vertexRemap, size_t nVerts,
+        _Out_writes_(nFaces * 3) index_t* ibout) noexcept
     {
-        if (!ib || !nFaces || !vertexRemap || !nVerts)
+        if (!ibin || !nFaces || !vertexRemap || !nVerts || !ibout)
             return E_INVALIDARG;
 
         if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
@@ -356,8 +467,12 @@ namespace
         if (nVerts >= index_t(-1))
             return E_INVALIDARG;
 
+        const size_t nIndices = nFaces * 3;
+        const int count = static_cast<int>((nIndices + c_BlockSize - 1) / c_BlockSize);
+
         std::unique_ptr<uint32_t[]> vertexRemapInverse(new (std::nothrow) uint32_t[nVerts]);
-        if (!vertexRemapInverse)
+        std::unique_ptr<HRESULT[]> results(new (std::nothrow) HRESULT[size_t(count)]);
+        if (!vertexRemapInverse || !results)
             return E_OUTOFMEMORY;
 
         memset(vertexRemapInverse.get(), 0xff, sizeof(uint32_t) * nVerts);
@@ -373,25 +488,156 @@ namespace
             }
         }
 
-        for (size_t j = 0; j < (nFaces * 3); ++j)
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
         {
-            index_t i = ib[j];
-            if (i == index_t(-1))
-                continue;
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nIndices);
 
-            if (i >= nVerts)
-                return E_UNEXPECTED;
+            HRESULT hr = S_OK;
+            for (size_t j = start; j < end; ++j)
+            {
+                const index_t i = ibin[j];
+                if (i == index_t(-1))
+                {
+                    ibout[j] = index_t(-1);
+                    continue;
+                }
 
-            const uint32_t dest = vertexRemapInverse[i];
-            if (dest == UNUSED32)
+                if (i >= nVerts)
+                {
+                    hr = E_UNEXPECTED;
+                    break;
+                }
+
+                const uint32_t dest = vertexRemapInverse[i];
+                ibout[j] = (dest == UNUSED32) ? i : index_t(dest);
+            }
+
+            results[block] = hr;
+        }
+
+        for (int block = 0; block < count; ++block)
+        {
+            if (FAILED(results[block]))
+                return results[block];
+        }
+
+        return S_OK;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Out-of-place reorder into the workspace followed by a copy back, which unlike
+    // SwapFaces can be split across threads
+    //---------------------------------------------------------------------------------
+    template<class T>
+    void CopyBlocks(_Out_writes_(count) T* dest, _In_reads_(count) const T* src, size_t count) noexcept
+    {
+        const int nBlocks = static_cast<int>((count + c_BlockSize - 1) / c_BlockSize);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (nBlocks > 1)
+    #endif
+        for (int block = 0; block < nBlocks; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, count);
+            memcpy(dest + start, src + start, sizeof(T) * (end - start));
+        }
+    }
+
+    template<class index_t>
+    HRESULT ReorderFacesWorkspace(
+        _Inout_updates_all_(nFaces * 3) index_t* ib, size_t nFaces,
+        _Inout_updates_all_opt_(nFaces * 3) uint32_t* adj,
+        _In_reads_(nFaces) const uint32_t* faceRemap,
+        std::vector<uint8_t>& workspace) noexcept
+    {
+        if (!ib || !nFaces || !faceRemap)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        bool hasUnused = false;
+        for (size_t j = 0; j < nFaces; ++j)
+        {
+            if (faceRemap[j] == UNUSED32)
+            {
+                hasUnused = true;
+                break;
+            }
+        }
+
+        const size_t nIndices = nFaces * 3;
+        const size_t ibBytes = (sizeof(index_t) * nIndices + 3) & ~size_t(3);
+        const size_t adjBytes = (adj) ? sizeof(uint32_t) * nIndices : 0;
+        const size_t inverseBytes = (hasUnused) ? sizeof(uint32_t) * nFaces : 0;
+
+        if (workspace.size() < (ibBytes + adjBytes + inverseBytes))
+        {
+            try
+            {
+                workspace.resize(ibBytes + adjBytes + inverseBytes);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return E_OUTOFMEMORY;
+            }
+        }
+
+        auto ibtemp = reinterpret_cast<index_t*>(workspace.data());
+        auto adjtemp = (adj) ? reinterpret_cast<uint32_t*>(workspace.data() + ibBytes) : nullptr;
+
+        // Snapshot the buffers to use as the source of the gather
+        CopyBlocks(ibtemp, ib, nIndices);
+        if (adj)
+        {
+            CopyBlocks(adjtemp, adj, nIndices);
+        }
+
+        HRESULT hr = ReorderFaces<index_t>(ibtemp, nFaces, adjtemp, faceRemap, ib, adj);
+        if (FAILED(hr) || !hasUnused)
+            return hr;
+
+        // Match SwapFaces, which leaves each face no one asked for in the unused slot at
+        // the end of its chain: walk the inverse back from the slot to the chain's head
+        auto faceRemapInverse = reinterpret_cast<uint32_t*>(workspace.data() + ibBytes + adjBytes);
+
+        memset(faceRemapInverse, 0xff, inverseBytes);
+
+        for (uint32_t j = 0; j < nFaces; ++j)
+        {
+            if (faceRemap[j] != UNUSED32)
+            {
+                faceRemapInverse[faceRemap[j]] = j;
+            }
+        }
+
+        for (size_t j = 0; j < nFaces; ++j)
+        {
+            if (faceRemap[j] != UNUSED32)
                 continue;
 
-            if (dest < nVerts)
+            size_t src = j;
+            while (faceRemapInverse[src] != UNUSED32)
             {
-                ib[j] = index_t(dest);
+                src = faceRemapInverse[src];
+            }
+
+            ib[j * 3] = ibtemp[src * 3];
+            ib[j * 3 + 1] = ibtemp[src * 3 + 1];
+            ib[j * 3 + 2] = ibtemp[src * 3 + 2];
+
+            if (adj)
+            {
+                adj[j * 3] = adjtemp[src * 3];
+                adj[j * 3 + 1] = adjtemp[src * 3 + 1];
+                adj[j * 3 + 2] = adjtemp[src * 3 + 2];
             }
-            else
-                return E_FAIL;
         }
 
         return S_OK;
@@ -439,6 +685,16 @@ HRESULT DirectX::ReorderIB(
     return SwapFaces<uint16_t>(ib, nFaces, nullptr, faceRemap);
 }
 
+_Use_decl_annotations_
+HRESULT DirectX::ReorderIB(
+    uint16_t* ib,
+    size_t nFaces,
+    const uint32_t* faceRemap,
+    std::vector<uint8_t>& workspace) noexcept
+{
+    return ReorderFacesWorkspace<uint16_t>(ib, nFaces, nullptr, faceRemap, workspace);
+}
+
 
 //-------------------------------------------------------------------------------------
 _Use_decl_annotations_
@@ -475,6 +731,16 @@ HRESULT DirectX::ReorderIB(
     return SwapFaces<uint32_t>(ib, nFaces, nullptr, faceRemap);
 }
 
+_Use_decl_annotations_
+HRESULT DirectX::ReorderIB(
+    uint32_t* ib,
+    size_t nFaces,
+    const uint32_t* faceRemap,
+    std::vector<uint8_t>& workspace) noexcept
+{
+    return ReorderFacesWorkspace<uint32_t>(ib, nFaces, nullptr, faceRemap, workspace);
+}
+
 
 //-------------------------------------------------------------------------------------
 // Applies a face remap reordering to an index buffer and adjacency
@@ -516,6 +782,20 @@ HRESULT DirectX::ReorderIBAndAdjacency(
     return SwapFaces<uint16_t>(ib, nFaces, adj, faceRemap);
 }
 
+_Use_decl_annotations_
+HRESULT DirectX::ReorderIBAndAdjacency(
+    uint16_t* ib,
+    size_t nFaces,
+    uint32_t* adj,
+    const uint32_t* faceRemap,
+    std::vector<uint8_t>& workspace) noexcept
+{
+    if (!adj)
+        return E_INVALIDARG;
+
+    return ReorderFacesWorkspace<uint16_t>(ib, nFaces, adj, faceRemap, workspace);
+}
+
 
 //-------------------------------------------------------------------------------------
 _Use_decl_annotations_
@@ -555,6 +835,20 @@ HRESULT DirectX::ReorderIBAndAdjacency(
     return SwapFaces<uint32_t>(ib, nFaces, adj, faceRemap);
 }
 
+_Use_decl_annotations_
+HRESULT DirectX::ReorderIBAndAdjacency(
+    uint32_t* ib,
+    size_t nFaces,
+    uint32_t* adj,
+    const uint32_t* faceRemap,
+    std::vector<uint8_t>& workspace) noexcept
+{
+    if (!adj)
+        return E_INVALIDARG;
+
+    return ReorderFacesWorkspace<uint32_t>(ib, nFaces, adj, faceRemap, workspace);
+}
+
 
 //-------------------------------------------------------------------------------------
 // Applies a vertex remap, filling out a new index buffer
@@ -577,7 +871,7 @@ HRESULT DirectX::FinalizeIB(
     const uint32_t* vertexRemap,
     size_t nVerts) noexcept
 {
-    return FinalizeIBImpl<uint16_t>(ib, nFaces, vertexRemap, nVerts);
+    return FinalizeIBImpl<uint16_t>(ib, nFaces, vertexRemap, nVerts, ib);
 }
 
 
@@ -600,7 +894,7 @@ HRESULT DirectX::FinalizeIB(
     const uint32_t* vertexRemap,
     size_t nVerts) noexcept
 {
-    return FinalizeIBImpl<uint32_t>(ib, nFaces, vertexRemap, nVerts);
+    return FinalizeIBImpl<uint32_t>(ib, nFaces, vertexRemap, nVerts, ib);
 }
 
 
@@ -705,6 +999,124 @@ HRESULT DirectX::FinalizeVB(
 }
 
 
+//-------------------------------------------------------------------------------------
+// Applies a vertex remap and/or a vertex duplication set to several vertex streams
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::FinalizeVB(
+    const void* const* vbin,
+    const size_t* strides,
+    size_t nStreams,
+    size_t nVerts,
+    const uint32_t* dupVerts,
+    size_t nDupVerts,
+    const uint32_t* vertexRemap,
+    void* const* vbout) noexcept
+{
+    if (!vbin || !strides || !nStreams || !nVerts || !vbout)
+        return E_INVALIDARG;
+
+    if (!dupVerts && !vertexRemap)
+        return E_INVALIDARG;
+
+    if (dupVerts && !nDupVerts)
+        return E_INVALIDARG;
+
+    if (!dupVerts && nDupVerts > 0)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nVerts) + uint64_t(nDupVerts)) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    for (size_t s = 0; s < nStreams; ++s)
+    {
+        if (!vbin[s] || !vbout[s] || !strides[s] || strides[s] > c_MaxStride)
+            return E_INVALIDARG;
+
+        if (vbin[s] == vbout[s])
+            return HRESULT_E_NOT_SUPPORTED;
+    }
+
+    const size_t newVerts = nVerts + nDupVerts;
+
+    // Validate up front so the copy can't fail part way through
+    if (vertexRemap)
+    {
+        for (size_t j = 0; j < newVerts; ++j)
+        {
+            const uint32_t src = vertexRemap[j];
+            if (src != UNUSED32 && src >= newVerts)
+                return E_UNEXPECTED;
+        }
+    }
+
+    for (size_t j = 0; j < nDupVerts; ++j)
+    {
+        if (dupVerts[j] >= nVerts)
+            return E_UNEXPECTED;
+    }
+
+#ifdef _DEBUG
+    for (size_t s = 0; s < nStreams; ++s)
+    {
+        memset(vbout[s], 0, newVerts * strides[s]);
+    }
+#endif
+
+    // Each block gathers its vertices for every stream, so the remap is only read once
+    const int count = static_cast<int>((newVerts + c_BlockSize - 1) / c_BlockSize);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+    for (int block = 0; block < count; ++block)
+    {
+        const size_t start = size_t(block) * c_BlockSize;
+        const size_t end = std::min(start + c_BlockSize, newVerts);
+
+        for (size_t j = start; j < end; ++j)
+        {
+            uint32_t src = (vertexRemap) ? vertexRemap[j] : uint32_t(j);
+
+            if (src == UNUSED32)
+                continue;
+
+            if (src >= nVerts)
+            {
+                src = dupVerts[src - nVerts];
+            }
+
+            for (size_t s = 0; s < nStreams; ++s)
+            {
+                const size_t stride = strides[s];
+                memcpy(static_cast<uint8_t*>(vbout[s]) + j * stride,
+                    static_cast<const uint8_t*>(vbin[s]) + size_t(src) * stride,
+                    stride);
+            }
+        }
+    }
+
+    return S_OK;
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::FinalizeVB(
+    void* const* vbs,
+    const size_t* strides,
+    size_t nStreams,
+    size_t nVerts,
+    const uint32_t* vertexRemap) noexcept
+{
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    return SwapVertexStreams(vbs, strides, nStreams, nVerts, vertexRemap);
+}
+
+
 //-------------------------------------------------------------------------------------
 // Applies a vertex remap and/or a vertex duplication set to a vertex buffer and
 // point representatives
@@ -938,3 +1350,331 @@ HRESULT DirectX::CompactVB(
 
     return S_OK;
 }
+
+
+//-------------------------------------------------------------------------------------
+// Generates an index buffer and vertex remap which weld bitwise identical vertices
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::GenerateVertexRemap(
+    const void* const* vbs,
+    const size_t* strides,
+    size_t nStreams,
+    size_t nVerts,
+    uint32_t* indices,
+    uint32_t* vertexRemap,
+    size_t* trailingUnused) noexcept
+{
+    if (trailingUnused)
+    {
+        *trailingUnused = 0;
+    }
+
+    if (!vbs || !strides || !nStreams || !nVerts || !indices || !vertexRemap)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if (indices == vertexRemap)
+        return HRESULT_E_NOT_SUPPORTED;
+
+    for (size_t s = 0; s < nStreams; ++s)
+    {
+        if (!vbs[s] || !strides[s] || strides[s] > c_MaxStride)
+            return E_INVALIDARG;
+    }
+
+    if ((uint64_t(nVerts) * 5 + c_HashPartitions) > (SIZE_MAX / sizeof(uint32_t)))
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    std::unique_ptr<const uint8_t*[]> streams(new (std::nothrow) const uint8_t*[nStreams]);
+    if (!streams)
+        return E_OUTOFMEMORY;
+
+    for (size_t s = 0; s < nStreams; ++s)
+    {
+        streams[s] = static_cast<const uint8_t*>(vbs[s]);
+    }
+
+    // Each partition owns a slice of the table with room for twice its vertices plus one,
+    // so the partition for vertices [start,end) begins at slot 2 * start + partition
+    const size_t tableSize = nVerts * 2 + c_HashPartitions;
+    const int count = static_cast<int>((nVerts + c_PartitionBlockSize - 1) / c_PartitionBlockSize);
+
+    std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nVerts * 3 + tableSize]);
+    std::unique_ptr<size_t[]> offsets(new (std::nothrow) size_t[size_t(count) * c_HashPartitions]);
+    if (!temp || !offsets)
+        return E_OUTOFMEMORY;
+
+    uint32_t* hashes = temp.get();
+    uint32_t* order = hashes + nVerts;
+    uint32_t* orderHashes = order + nVerts;
+    uint32_t* table = orderHashes + nVerts;
+
+    const uint8_t* const* vbptr = streams.get();
+    constexpr uint32_t shift = 32 - c_HashPartitionBits;
+
+    // Hash every vertex and count the partitions each block of vertices falls into
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+    for (int block = 0; block < count; ++block)
+    {
+        size_t* hist = &offsets[size_t(block) * c_HashPartitions];
+        memset(hist, 0, sizeof(size_t) * c_HashPartitions);
+
+        const size_t start = size_t(block) * c_PartitionBlockSize;
+        const size_t end = std::min(start + c_PartitionBlockSize, nVerts);
+        for (size_t v = start; v < end; ++v)
+        {
+            const uint32_t h = HashVertex(vbptr, strides, nStreams, v);
+            hashes[v] = h;
+            ++hist[h >> shift];
+        }
+    }
+
+    // Partition-major prefix sum keeps each partition in ascending vertex order, so the
+    // first occurrence of a vertex is the one found in the table
+    size_t partStart[c_HashPartitions + 1] = {};
+    size_t total = 0;
+    for (size_t part = 0; part < c_HashPartitions; ++part)
+    {
+        partStart[part] = total;
+        for (int block = 0; block < count; ++block)
+        {
+            size_t& entry = offsets[size_t(block) * c_HashPartitions + part];
+            const size_t n = entry;
+            entry = total;
+            total += n;
+        }
+    }
+    partStart[c_HashPartitions] = total;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+    for (int block = 0; block < count; ++block)
+    {
+        size_t* next = &offsets[size_t(block) * c_HashPartitions];
+
+        const size_t start = size_t(block) * c_PartitionBlockSize;
+        const size_t end = std::min(start + c_PartitionBlockSize, nVerts);
+        for (size_t v = start; v < end; ++v)
+        {
+            // The hash travels with the vertex so the table build reads it sequentially
+            const uint32_t h = hashes[v];
+            const size_t dest = next[h >> shift]++;
+            order[dest] = static_cast<uint32_t>(v);
+            orderHashes[dest] = h;
+        }
+    }
+
+    // Build each partition's open-addressing table of positions in the partition order,
+    // pointing every vertex at the first vertex with the same hash. Only the hashes are
+    // read here, as visiting the vertex data in partition order would miss the cache.
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+    for (int part = 0; part < static_cast<int>(c_HashPartitions); ++part)
+    {
+        const size_t start = partStart[part];
+        const size_t end = partStart[part + 1];
+        const size_t capacity = (end - start) * 2 + 1;
+
+        uint32_t* slots = table + start * 2 + size_t(part);
+        memset(slots, 0xff, sizeof(uint32_t) * capacity);
+
+        for (size_t j = start; j < end; ++j)
+        {
+            const uint32_t h = orderHashes[j];
+
+            // The low bits of the hash select the slot, as the top bits are the same for the whole partition
+            size_t slot = static_cast<size_t>((uint64_t(h & ((1u << shift) - 1)) * capacity) >> shift);
+            for (;;)
+            {
+                const uint32_t k = slots[slot];
+                if (k == UNUSED32)
+                {
+                    slots[slot] = static_cast<uint32_t>(j);
+                    indices[order[j]] = order[j];
+                    break;
+                }
+
+                if (orderHashes[k] == h)
+                {
+                    indices[order[j]] = order[k];
+                    break;
+                }
+
+                if (++slot == capacity)
+                {
+                    slot = 0;
+                }
+            }
+        }
+    }
+
+    // Confirm each match in vertex order, where duplicates in a soup are usually close by,
+    // and mark vertices whose hash collided with a different vertex
+    const int idCount = static_cast<int>((nVerts + c_BlockSize - 1) / c_BlockSize);
+    size_t* blockStart = offsets.get(); // count * c_HashPartitions is at least idCount
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (idCount > 1)
+    #endif
+    for (int block = 0; block < idCount; ++block)
+    {
+        const size_t start = size_t(block) * c_BlockSize;
+        const size_t end = std::min(start + c_BlockSize, nVerts);
+
+        size_t n = 0;
+        for (size_t v = start; v < end; ++v)
+        {
+            const uint32_t w = indices[v];
+            if (w != v && !EqualVertices(vbptr, strides, nStreams, w, v))
+            {
+                indices[v] = UNUSED32;
+                ++n;
+            }
+        }
+        blockStart[block] = n;
+    }
+
+    size_t nCollided = 0;
+    for (int block = 0; block < idCount; ++block)
+    {
+        const size_t n = blockStart[block];
+        blockStart[block] = nCollided;
+        nCollided += n;
+    }
+
+    if (nCollided > 0)
+    {
+        // A collided vertex differs from every vertex matching the first one with its hash, so
+        // its first occurrence is an earlier collided vertex with the same hash, or itself
+        std::unique_ptr<uint64_t[]> collided(new (std::nothrow) uint64_t[nCollided]);
+        if (!collided)
+            return E_OUTOFMEMORY;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (idCount > 1)
+    #endif
+        for (int block = 0; block < idCount; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nVerts);
+
+            size_t next = blockStart[block];
+            for (size_t v = start; v < end; ++v)
+            {
+                if (indices[v] == UNUSED32)
+                {
+                    collided[next++] = (uint64_t(hashes[v]) << 32) | v;
+                }
+            }
+        }
+
+        std::sort(collided.get(), collided.get() + nCollided);
+
+        for (size_t group = 0; group < nCollided;)
+        {
+            size_t groupEnd = group + 1;
+            while (groupEnd < nCollided && (collided[groupEnd] >> 32) == (collided[group] >> 32))
+            {
+                ++groupEnd;
+            }
+
+            for (size_t j = group; j < groupEnd; ++j)
+            {
+                const auto v = static_cast<uint32_t>(collided[j]);
+                indices[v] = v;
+
+                for (size_t k = group; k < j; ++k)
+                {
+                    const auto w = static_cast<uint32_t>(collided[k]);
+                    if (indices[w] == w && EqualVertices(vbptr, strides, nStreams, w, v))
+                    {
+                        indices[v] = w;
+                        break;
+                    }
+                }
+            }
+
+            group = groupEnd;
+        }
+    }
+
+    // Number the unique vertices in order of first occurrence, reusing the hashes for the new ids
+    uint32_t* ids = hashes;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (idCount > 1)
+    #endif
+    for (int block = 0; block < idCount; ++block)
+    {
+        const size_t start = size_t(block) * c_BlockSize;
+        const size_t end = std::min(start + c_BlockSize, nVerts);
+
+        size_t n = 0;
+        for (size_t v = start; v < end; ++v)
+        {
+            n += (indices[v] == v) ? 1u : 0u;
+        }
+        blockStart[block] = n;
+    }
+
+    size_t nUnique = 0;
+    for (int block = 0; block < idCount; ++block)
+    {
+        const size_t n = blockStart[block];
+        blockStart[block] = nUnique;
+        nUnique += n;
+    }
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (idCount > 1)
+    #endif
+    for (int block = 0; block < idCount; ++block)
+    {
+        const size_t start = size_t(block) * c_BlockSize;
+        const size_t end = std::min(start + c_BlockSize, nVerts);
+
+        size_t id = blockStart[block];
+        for (size_t v = start; v < end; ++v)
+        {
+            if (indices[v] == v)
+            {
+                ids[v] = static_cast<uint32_t>(id);
+                vertexRemap[id] = static_cast<uint32_t>(v);
+                ++id;
+            }
+        }
+    }
+
+    // Point each index at the new id of its first occurrence
+    #ifdef _OPENMP
+    #pragma omp parallel for if (idCount > 1)
+    #endif
+    for (int block = 0; block < idCount; ++block)
+    {
+        const size_t start = size_t(block) * c_BlockSize;
+        const size_t end = std::min(start + c_BlockSize, nVerts);
+        for (size_t v = start; v < end; ++v)
+        {
+            indices[v] = ids[indices[v]];
+        }
+    }
+
+    for (size_t j = nUnique; j < nVerts; ++j)
+    {
+        vertexRemap[j] = UNUSED32;
+    }
+
+    if (trailingUnused)
+    {
+        *trailingUnused = nVerts - nUnique;
+    }
+
+    return S_OK;
+}
@@ -0,0 +1,230 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshSplitIB.cpp
+//
+// DirectX Mesh Geometry Library - 16-bit index buffer splitting
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// https://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Per-vertex state for the chunk currently being built. Vertices are tagged with the
+    // chunk number rather than cleared between chunks.
+    //---------------------------------------------------------------------------------
+    class chunk_state
+    {
+    public:
+        chunk_state() noexcept :
+            mChunk(0),
+            mVertexCount(0)
+        {}
+
+        HRESULT initialize(size_t nVerts) noexcept
+        {
+            mStamp.reset(new (std::nothrow) uint32_t[nVerts]);
+            mLocal.reset(new (std::nothrow) uint16_t[nVerts]);
+            mAssigned.reset(new (std::nothrow) uint8_t[nVerts]);
+            if (!mStamp || !mLocal || !mAssigned)
+                return E_OUTOFMEMORY;
+
+            memset(mStamp.get(), 0, sizeof(uint32_t) * nVerts);
+            memset(mAssigned.get(), 0, sizeof(uint8_t) * nVerts);
+
+            return S_OK;
+        }
+
+        void reset() noexcept
+        {
+            ++mChunk;
+            mVertexCount = 0;
+        }
+
+        size_t count() const noexcept { return mVertexCount; }
+
+        // Number of vertices of the face that are not yet in the current chunk
+        size_t missing(_In_reads_(3) const uint32_t* face) const noexcept
+        {
+            size_t result = 0;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                if (mStamp[face[j]] == mChunk)
+                    continue;
+
+                if (j > 0 && face[j] == face[0])
+                    continue;
+
+                if (j > 1 && face[j] == face[1])
+                    continue;
+
+                ++result;
+            }
+
+            return result;
+        }
+
+        // Returns the chunk-local index of the vertex, adding it to the chunk if needed
+        uint16_t add(uint32_t v, size_t nVerts, std::vector<uint32_t>& dupVerts, std::vector<uint32_t>& vertexRemap)
+        {
+            if (mStamp[v] == mChunk)
+                return mLocal[v];
+
+            mStamp[v] = mChunk;
+            mLocal[v] = static_cast<uint16_t>(mVertexCount++);
+
+            // The first chunk to use a vertex keeps the original, later ones get a duplicate
+            if (!mAssigned[v])
+            {
+                mAssigned[v] = 1;
+                vertexRemap.push_back(v);
+            }
+            else
+            {
+                vertexRemap.push_back(static_cast<uint32_t>(nVerts + dupVerts.size()));
+                dupVerts.push_back(v);
+            }
+
+            return mLocal[v];
+        }
+
+        bool assigned(uint32_t v) const noexcept { return mAssigned[v] != 0; }
+
+    private:
+        std::unique_ptr<uint32_t[]> mStamp;
+        std::unique_ptr<uint16_t[]> mLocal;
+        std::unique_ptr<uint8_t[]>  mAssigned;
+        uint32_t                    mChunk;
+        size_t                      mVertexCount;
+    };
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::SplitIB16(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* attributes,
+    std::vector<IndexBufferChunk>& chunks,
+    std::vector<uint16_t>& indices16,
+    std::vector<uint32_t>& dupVerts,
+    std::vector<uint32_t>& vertexRemap,
+    size_t maxVerts)
+{
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (maxVerts < 3 || maxVerts > SPLITIB16_MAX_VERTS)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    for (size_t j = 0; j < (nFaces * 3); ++j)
+    {
+        if (indices[j] != UNUSED32 && indices[j] >= nVerts)
+            return E_UNEXPECTED;
+    }
+
+    chunk_state state;
+    HRESULT hr = state.initialize(nVerts);
+    if (FAILED(hr))
+        return hr;
+
+    chunks.clear();
+    dupVerts.clear();
+    vertexRemap.clear();
+    indices16.resize(nFaces * 3);
+    vertexRemap.reserve(nVerts);
+
+    uint16_t* dest = indices16.data();
+
+    size_t faceBegin = 0;
+    while (faceBegin < nFaces)
+    {
+        const uint32_t attr = (attributes) ? attributes[faceBegin] : 0;
+
+        size_t faceEnd = faceBegin + 1;
+        if (attributes)
+        {
+            while (faceEnd < nFaces && attributes[faceEnd] == attr)
+                ++faceEnd;
+        }
+        else
+        {
+            faceEnd = nFaces;
+        }
+
+        // Chunks follow the existing face order so vertex cache optimization is preserved
+        size_t chunkStart = faceBegin;
+        state.reset();
+        for (size_t face = faceBegin; face < faceEnd; ++face)
+        {
+            const uint32_t* src = &indices[face * 3];
+            if (src[0] == UNUSED32 || src[1] == UNUSED32 || src[2] == UNUSED32)
+            {
+                dest[0] = dest[1] = dest[2] = uint16_t(-1);
+                dest += 3;
+                continue;
+            }
+
+            if ((state.count() + state.missing(src)) > maxVerts)
+            {
+                const size_t vertexCount = state.count();
+                chunks.push_back({ attr,
+                    static_cast<uint32_t>(vertexRemap.size() - vertexCount),
+                    static_cast<uint32_t>(vertexCount),
+                    static_cast<uint32_t>(chunkStart * 3),
+                    static_cast<uint32_t>((face - chunkStart) * 3) });
+
+                chunkStart = face;
+                state.reset();
+            }
+
+            for (size_t j = 0; j < 3; ++j)
+            {
+                *dest++ = state.add(src[j], nVerts, dupVerts, vertexRemap);
+            }
+
+            if ((uint64_t(nVerts) + dupVerts.size()) >= UINT32_MAX)
+                return HRESULT_E_ARITHMETIC_OVERFLOW;
+        }
+
+        const size_t vertexCount = state.count();
+        chunks.push_back({ attr,
+            static_cast<uint32_t>(vertexRemap.size() - vertexCount),
+            static_cast<uint32_t>(vertexCount),
+            static_cast<uint32_t>(chunkStart * 3),
+            static_cast<uint32_t>((faceEnd - chunkStart) * 3) });
+
+        faceBegin = faceEnd;
+    }
+
+    assert(dest == indices16.data() + nFaces * 3);
+
+    // Vertices not referenced by any face are kept at the end
+    for (uint32_t j = 0; j < nVerts; ++j)
+    {
+        if (!state.assigned(j))
+        {
+            vertexRemap.push_back(j);
+        }
+    }
+
+    assert(vertexRemap.size() == (nVerts + dupVerts.size()));
+
+    return S_OK;
+}
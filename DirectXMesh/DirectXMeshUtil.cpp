@@ -446,6 +446,286 @@ std::vector<std::pair<size_t, size_t>> DirectX::ComputeSubsets(const uint32_t* a
 
 namespace
 {
+    //---------------------------------------------------------------------------------
+    // Post-transform vertex cache simulation with O(1) cost per index
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    class vcache_sim
+    {
+    public:
+        vcache_sim() noexcept :
+            mModel(VCACHE_FIFO),
+            mCacheSize(0),
+            mBatchPrims(0),
+            mTime(0),
+            mBatchVerts(0),
+            mBatchPrimCount(0),
+            mHead(UNUSED32),
+            mTail(UNUSED32),
+            mCount(0)
+        {}
+
+        HRESULT initialize(const VertexCacheModel& model, size_t nVerts) noexcept
+        {
+            switch (model.Model)
+            {
+            case VCACHE_FIFO:
+            case VCACHE_LRU:
+                if (!model.CacheSize)
+                    return E_INVALIDARG;
+                break;
+
+            case VCACHE_BATCH:
+                // A batch must be able to hold at least one triangle
+                if (model.CacheSize < 3)
+                    return E_INVALIDARG;
+                break;
+
+            default:
+                return E_INVALIDARG;
+            }
+
+            mModel = model.Model;
+            mCacheSize = model.CacheSize;
+            mBatchPrims = model.BatchPrims;
+
+            if (mModel == VCACHE_LRU)
+            {
+                mPrev.reset(new (std::nothrow) uint32_t[nVerts]);
+                mNext.reset(new (std::nothrow) uint32_t[nVerts]);
+                mCached.reset(new (std::nothrow) uint8_t[nVerts]);
+                if (!mPrev || !mNext || !mCached)
+                    return E_OUTOFMEMORY;
+
+                memset(mCached.get(), 0, sizeof(uint8_t) * nVerts);
+            }
+            else
+            {
+                mStamps.reset(new (std::nothrow) uint64_t[nVerts]);
+                if (!mStamps)
+                    return E_OUTOFMEMORY;
+
+                memset(mStamps.get(), 0, sizeof(uint64_t) * nVerts);
+            }
+
+            // FIFO timestamps start far enough ahead that every vertex begins outside the cache,
+            // batch stamps start with batch 1
+            mTime = (mModel == VCACHE_FIFO) ? (uint64_t(mCacheSize) + 1) : 1;
+
+            return S_OK;
+        }
+
+        // Returns the number of vertices transformed for the face
+        uint32_t add(_In_reads_(3) const index_t* face) noexcept
+        {
+            switch (mModel)
+            {
+            case VCACHE_LRU:
+                return uint32_t(accessLRU(face[0])) + uint32_t(accessLRU(face[1])) + uint32_t(accessLRU(face[2]));
+
+            case VCACHE_BATCH:
+                return addBatch(face);
+
+            default:
+                return uint32_t(accessFIFO(face[0])) + uint32_t(accessFIFO(face[1])) + uint32_t(accessFIFO(face[2]));
+            }
+        }
+
+    private:
+        bool accessFIFO(index_t v) noexcept
+        {
+            if (v == index_t(-1))
+                return false;
+
+            // A vertex inserted at time t is evicted once mCacheSize more vertices have been inserted
+            if ((mTime - mStamps[v]) > mCacheSize)
+            {
+                mStamps[v] = mTime++;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool accessLRU(index_t v) noexcept
+        {
+            if (v == index_t(-1))
+                return false;
+
+            if (mCached[v])
+            {
+                // Hit: move to the front of the list
+                if (mHead != v)
+                {
+                    unlink(v);
+                    pushFront(v);
+                }
+                return false;
+            }
+
+            if (mCount == mCacheSize)
+            {
+                // Miss: evict the least recently used vertex
+                unlink(mTail);
+            }
+
+            pushFront(v);
+            return true;
+        }
+
+        uint32_t addBatch(_In_reads_(3) const index_t* face) noexcept
+        {
+            const index_t i0 = face[0];
+            const index_t i1 = face[1];
+            const index_t i2 = face[2];
+
+            if (i0 == index_t(-1) && i1 == index_t(-1) && i2 == index_t(-1))
+                return 0;
+
+            // Distinct vertices of the face
+            index_t verts[3];
+            uint32_t count = 0;
+            if (i0 != index_t(-1))
+                verts[count++] = i0;
+            if (i1 != index_t(-1) && i1 != i0)
+                verts[count++] = i1;
+            if (i2 != index_t(-1) && i2 != i0 && i2 != i1)
+                verts[count++] = i2;
+
+            uint32_t added = 0;
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                if (mStamps[verts[j]] != mTime)
+                    ++added;
+            }
+
+            if ((mBatchVerts + added) > mCacheSize || (mBatchPrims && mBatchPrimCount >= mBatchPrims))
+            {
+                // Start a new batch, nothing is shared with the previous one
+                ++mTime;
+                mBatchVerts = 0;
+                mBatchPrimCount = 0;
+                added = count;
+            }
+
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                mStamps[verts[j]] = mTime;
+            }
+
+            mBatchVerts += added;
+            ++mBatchPrimCount;
+
+            return added;
+        }
+
+        void unlink(uint32_t v) noexcept
+        {
+            const uint32_t prev = mPrev[v];
+            const uint32_t next = mNext[v];
+
+            if (prev != UNUSED32)
+                mNext[prev] = next;
+            else
+                mHead = next;
+
+            if (next != UNUSED32)
+                mPrev[next] = prev;
+            else
+                mTail = prev;
+
+            mCached[v] = 0;
+            --mCount;
+        }
+
+        void pushFront(uint32_t v) noexcept
+        {
+            mPrev[v] = UNUSED32;
+            mNext[v] = mHead;
+
+            if (mHead != UNUSED32)
+                mPrev[mHead] = v;
+            else
+                mTail = v;
+
+            mHead = v;
+            mCached[v] = 1;
+            ++mCount;
+        }
+
+        std::unique_ptr<uint64_t[]> mStamps;
+        std::unique_ptr<uint32_t[]> mPrev;
+        std::unique_ptr<uint32_t[]> mNext;
+        std::unique_ptr<uint8_t[]>  mCached;
+        VCACHE_MODEL                mModel;
+        uint32_t                    mCacheSize;
+        uint32_t                    mBatchPrims;
+        uint64_t                    mTime;
+        uint32_t                    mBatchVerts;
+        uint32_t                    mBatchPrimCount;
+        uint32_t                    mHead;
+        uint32_t                    mTail;
+        uint32_t                    mCount;
+    };
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ComputeVertexCacheMissRateImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nModels) const VertexCacheModel* models, size_t nModels,
+        _Out_writes_(nModels) VertexCacheStats* stats) noexcept
+    {
+        if (!indices || !nFaces || !nVerts || !models || !nModels || !stats)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            if (indices[j] != index_t(-1) && indices[j] >= nVerts)
+                return E_UNEXPECTED;
+        }
+
+        std::unique_ptr<vcache_sim<index_t>[]> sims(new (std::nothrow) vcache_sim<index_t>[nModels]);
+        std::unique_ptr<uint64_t[]> misses(new (std::nothrow) uint64_t[nModels]);
+        if (!sims || !misses)
+            return E_OUTOFMEMORY;
+
+        for (size_t m = 0; m < nModels; ++m)
+        {
+            HRESULT hr = sims[m].initialize(models[m], nVerts);
+            if (FAILED(hr))
+                return hr;
+
+            misses[m] = 0;
+        }
+
+        // All models are evaluated in a single pass over the index buffer
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            const index_t* tri = &indices[face * 3];
+            for (size_t m = 0; m < nModels; ++m)
+            {
+                misses[m] += sims[m].add(tri);
+            }
+        }
+
+        for (size_t m = 0; m < nModels; ++m)
+        {
+            // ideal is 0.5, individual tris have 3.0
+            stats[m].ACMR = float(misses[m]) / float(nFaces);
+
+            // ideal is 1.0, worst case is 6.0
+            stats[m].ATVR = float(misses[m]) / float(nVerts);
+        }
+
+        return S_OK;
+    }
+
     template<class index_t>
     void ComputeVertexCacheMissRateImpl(
         _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts, size_t cacheSize,
@@ -454,58 +734,114 @@ namespace
         acmr = -1.f;
         atvr = -1.f;
 
-        if (!indices || !nFaces || !nVerts || !cacheSize)
+        if (cacheSize >= UINT32_MAX)
             return;
 
-        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        const VertexCacheModel model = { VCACHE_FIFO, static_cast<uint32_t>(cacheSize), 0 };
+
+        VertexCacheStats stats = {};
+        if (FAILED(ComputeVertexCacheMissRateImpl<index_t>(indices, nFaces, nVerts, &model, 1, &stats)))
             return;
 
+        acmr = stats.ACMR;
+        atvr = stats.ATVR;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ComputeVertexFetchStatsImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nStreams) const size_t* strides, size_t nStreams,
+        _Out_writes_(nStreams) VertexFetchStats* stats,
+        size_t lineSize, size_t cacheSize) noexcept
+    {
+        if (!indices || !nFaces || !nVerts || !strides || !nStreams || !stats)
+            return E_INVALIDARG;
+
+        if (!lineSize || cacheSize < lineSize)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
         if (nVerts >= index_t(-1))
-            return;
+            return E_INVALIDARG;
 
-        size_t misses = 0;
+        // Each stream occupies its own range of cache lines
+        std::unique_ptr<uint64_t[]> lineBase(new (std::nothrow) uint64_t[nStreams]);
+        std::unique_ptr<uint64_t[]> fetched(new (std::nothrow) uint64_t[nStreams]);
+        if (!lineBase || !fetched)
+            return E_OUTOFMEMORY;
 
-        std::unique_ptr<uint32_t[]> fifo(new (std::nothrow) uint32_t[cacheSize]);
-        if (!fifo)
-            return;
+        uint64_t totalLines = 0;
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            if (!strides[s] || strides[s] > UINT32_MAX)
+                return E_INVALIDARG;
 
-        size_t tail = 0;
+            lineBase[s] = totalLines;
+            fetched[s] = 0;
+            totalLines += (uint64_t(nVerts) * strides[s] + lineSize - 1) / lineSize;
+        }
 
-        memset(fifo.get(), 0xff, sizeof(uint32_t) * cacheSize);
+        if (totalLines >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
 
+        std::unique_ptr<uint64_t[]> lineStamps(new (std::nothrow) uint64_t[size_t(totalLines)]);
+        std::unique_ptr<uint8_t[]> referenced(new (std::nothrow) uint8_t[nVerts]);
+        if (!lineStamps || !referenced)
+            return E_OUTOFMEMORY;
+
+        memset(lineStamps.get(), 0, sizeof(uint64_t) * size_t(totalLines));
+        memset(referenced.get(), 0, sizeof(uint8_t) * nVerts);
+
+        // FIFO replacement over cacheSize / lineSize lines shared by all streams
+        const uint64_t cacheLines = cacheSize / lineSize;
+        uint64_t time = cacheLines + 1;
+
+        size_t distinct = 0;
         for (size_t j = 0; j < (nFaces * 3); ++j)
         {
-            if (indices[j] == index_t(-1))
+            const index_t v = indices[j];
+            if (v == index_t(-1))
                 continue;
 
-            if (indices[j] >= nVerts)
-                return;
-
-            bool found = false;
+            if (v >= nVerts)
+                return E_UNEXPECTED;
 
-            for (size_t ptr = 0; ptr < cacheSize; ++ptr)
+            if (!referenced[v])
             {
-                if (fifo[ptr] == indices[j])
-                {
-                    found = true;
-                    break;
-                }
+                referenced[v] = 1;
+                ++distinct;
             }
 
-            if (!found)
+            for (size_t s = 0; s < nStreams; ++s)
             {
-                ++misses;
-                fifo[tail] = indices[j];
-                ++tail;
-                if (tail == cacheSize) tail = 0;
+                const uint64_t start = uint64_t(v) * strides[s];
+                const uint64_t firstLine = start / lineSize;
+                const uint64_t lastLine = (start + strides[s] - 1) / lineSize;
+
+                for (uint64_t line = firstLine; line <= lastLine; ++line)
+                {
+                    uint64_t& stamp = lineStamps[size_t(lineBase[s] + line)];
+                    if ((time - stamp) > cacheLines)
+                    {
+                        stamp = time++;
+                        fetched[s] += lineSize;
+                    }
+                }
             }
         }
 
-        // ideal is 0.5, individual tris have 3.0
-        acmr = float(misses) / float(nFaces);
+        for (size_t s = 0; s < nStreams; ++s)
+        {
+            stats[s].BytesFetched = size_t(fetched[s]);
+
+            // ideal is 1.0, each vertex read exactly once
+            stats[s].Overfetch = (distinct > 0) ? float(double(fetched[s]) / (double(distinct) * double(strides[s]))) : 0.f;
+        }
 
-        // ideal is 1.0, worst case is 6.0
-        atvr = float(misses) / float(nVerts);
+        return S_OK;
     }
 }
 
@@ -525,3 +861,43 @@ void DirectX::ComputeVertexCacheMissRate(
 {
     ComputeVertexCacheMissRateImpl<uint32_t>(indices, nFaces, nVerts, cacheSize, acmr, atvr);
 }
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeVertexCacheMissRate(
+    const uint16_t* indices, size_t nFaces, size_t nVerts,
+    const VertexCacheModel* models, size_t nModels,
+    VertexCacheStats* stats) noexcept
+{
+    return ComputeVertexCacheMissRateImpl<uint16_t>(indices, nFaces, nVerts, models, nModels, stats);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeVertexCacheMissRate(
+    const uint32_t* indices, size_t nFaces, size_t nVerts,
+    const VertexCacheModel* models, size_t nModels,
+    VertexCacheStats* stats) noexcept
+{
+    return ComputeVertexCacheMissRateImpl<uint32_t>(indices, nFaces, nVerts, models, nModels, stats);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ComputeVertexFetchStats(
+    const uint16_t* indices, size_t nFaces, size_t nVerts,
+    const size_t* strides, size_t nStreams,
+    VertexFetchStats* stats,
+    size_t lineSize, size_t cacheSize) noexcept
+{
+    return ComputeVertexFetchStatsImpl<uint16_t>(indices, nFaces, nVerts, strides, nStreams, stats, lineSize, cacheSize);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeVertexFetchStats(
+    const uint32_t* indices, size_t nFaces, size_t nVerts,
+    const size_t* strides, size_t nStreams,
+    VertexFetchStats* stats,
+    size_t lineSize, size_t cacheSize) noexcept
+{
+    return ComputeVertexFetchStatsImpl<uint32_t>(indices, nFaces, nVerts, strides, nStreams, stats, lineSize, cacheSize);
+}
@@ -19,6 +19,8 @@ using namespace DirectX;
 
 namespace
 {
+    constexpr size_t c_BlockSize = 4096;
+
 #ifndef _WIN32
     template<size_t sizeOfBuffer>
     inline int swprintf_s(wchar_t(&buffer)[sizeOfBuffer], const wchar_t* format, ...)
@@ -32,6 +34,143 @@ namespace
     }
 #endif
 
+    enum FACE_ISSUES : uint32_t
+    {
+        FACE_INVALID_INDEX = 0x1,
+        FACE_UNUSED = 0x2,
+        FACE_DEGENERATE = 0x4,
+        FACE_BACKFACING = 0x8,
+        FACE_ASYMMETRIC_ADJ = 0x10,
+    };
+
+    // Number of blocks checked at a time by VALIDATE_QUICK before testing for an early exit
+    constexpr int c_QuickWave = 16;
+
+    // Per-face problem classes requested by the flags; bowties are not a per-face class,
+    // as they are found by walking fans after all faces are checked
+    inline uint32_t RequestedIssues(VALIDATE_FLAGS flags, bool hasAdjacency) noexcept
+    {
+        uint32_t issues = 0;
+
+        if (flags & VALIDATE_UNUSED)
+            issues |= FACE_UNUSED;
+
+        if (flags & VALIDATE_DEGENERATE)
+            issues |= FACE_DEGENERATE;
+
+        if (hasAdjacency)
+        {
+            if (flags & VALIDATE_BACKFACING)
+                issues |= FACE_BACKFACING;
+
+            if (flags & VALIDATE_ASYMMETRIC_ADJ)
+                issues |= FACE_ASYMMETRIC_ADJ;
+        }
+
+        return issues;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Returns the problems found with a single face, applying the same rules as
+    // ValidateIndices without building any messages
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    uint32_t CheckFace(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ VALIDATE_FLAGS flags, _In_ size_t face) noexcept
+    {
+        uint32_t issues = 0;
+
+        // Check for values in-range
+        for (size_t point = 0; point < 3; ++point)
+        {
+            const index_t i = indices[face * 3 + point];
+            if (i >= nVerts && i != index_t(-1))
+                issues |= FACE_INVALID_INDEX;
+
+            if (adjacency)
+            {
+                const uint32_t j = adjacency[face * 3 + point];
+                if (j >= nFaces && j != UNUSED32)
+                    issues |= FACE_INVALID_INDEX;
+            }
+        }
+
+        // Check for unused faces
+        const index_t i0 = indices[face * 3];
+        const index_t i1 = indices[face * 3 + 1];
+        const index_t i2 = indices[face * 3 + 2];
+        if (i0 == index_t(-1)
+            || i1 == index_t(-1)
+            || i2 == index_t(-1))
+        {
+            if (flags & VALIDATE_UNUSED)
+            {
+                if (i0 != i1
+                    || i0 != i2
+                    || i1 != i2)
+                {
+                    issues |= FACE_UNUSED;
+                }
+
+                if (adjacency)
+                {
+                    for (size_t point = 0; point < 3; ++point)
+                    {
+                        if (adjacency[face * 3 + point] != UNUSED32)
+                            issues |= FACE_UNUSED;
+                    }
+                }
+            }
+
+            return issues;
+        }
+
+        // Check for degenerate triangles
+        if (i0 == i1
+            || i0 == i2
+            || i1 == i2)
+        {
+            if (flags & VALIDATE_DEGENERATE)
+                issues |= FACE_DEGENERATE;
+
+            return issues;
+        }
+
+        // Check for symmetric neighbors, which the bowtie check also relies on
+        if ((flags & (VALIDATE_ASYMMETRIC_ADJ | VALIDATE_BOWTIES)) && adjacency)
+        {
+            for (size_t point = 0; point < 3; ++point)
+            {
+                const uint32_t k = adjacency[face * 3 + point];
+                if (k >= nFaces)
+                    continue;
+
+                if (find_edge<uint32_t>(&adjacency[k * 3], uint32_t(face)) >= 3)
+                    issues |= FACE_ASYMMETRIC_ADJ;
+            }
+        }
+
+        // Check for duplicate neighbor
+        if ((flags & VALIDATE_BACKFACING) && adjacency)
+        {
+            const uint32_t j0 = adjacency[face * 3];
+            const uint32_t j1 = adjacency[face * 3 + 1];
+            const uint32_t j2 = adjacency[face * 3 + 2];
+
+            if ((j0 == j1 && j0 != UNUSED32)
+                || (j0 == j2 && j0 != UNUSED32)
+                || (j1 == j2 && j1 != UNUSED32))
+            {
+                issues |= FACE_BACKFACING;
+            }
+        }
+
+        return issues;
+    }
+
+
     //---------------------------------------------------------------------------------
     // Validates indices and optionally the adjacency information
     //---------------------------------------------------------------------------------
@@ -65,8 +204,22 @@ namespace
                 return E_INVALIDARG;
         }
 
+        // With VALIDATE_QUICK only the first problem of each class is described
+        const bool quick = (flags & VALIDATE_QUICK) != 0;
+        const uint32_t requested = RequestedIssues(flags, adjacency != nullptr);
+        uint32_t reported = 0;
+        auto describe = [&](uint32_t issue) noexcept -> bool
+            {
+                const bool first = !(reported & issue);
+                reported |= issue;
+                return first || !quick;
+            };
+
         for (size_t face = 0; face < nFaces; ++face)
         {
+            if (quick && ((reported & FACE_INVALID_INDEX) || (requested && (reported & requested) == requested)))
+                break;
+
             // Check for values in-range
             for (size_t point = 0; point < 3; ++point)
             {
@@ -78,9 +231,12 @@ namespace
 
                     result = false;
 
-                    wchar_t buff[128] = {};
-                    swprintf_s(buff, L"An invalid index value (%u) was found on face %zu\n", i, face);
-                    *msgs += buff;
+                    if (describe(FACE_INVALID_INDEX))
+                    {
+                        wchar_t buff[128] = {};
+                        swprintf_s(buff, L"An invalid index value (%u) was found on face %zu\n", i, face);
+                        *msgs += buff;
+                    }
                 }
 
                 if (adjacency)
@@ -93,9 +249,12 @@ namespace
 
                         result = false;
 
-                        wchar_t buff[128] = {};
-                        swprintf_s(buff, L"An invalid neighbor index value (%u) was found on face %zu\n", j, face);
-                        *msgs += buff;
+                        if (describe(FACE_INVALID_INDEX))
+                        {
+                            wchar_t buff[128] = {};
+                            swprintf_s(buff, L"An invalid neighbor index value (%u) was found on face %zu\n", j, face);
+                            *msgs += buff;
+                        }
                     }
                 }
             }
@@ -119,9 +278,12 @@ namespace
 
                         result = false;
 
-                        wchar_t buff[128] = {};
-                        swprintf_s(buff, L"An unused face (%zu) contains 'valid' but ignored vertices (%u,%u,%u)\n", face, i0, i1, i2);
-                        *msgs += buff;
+                        if (describe(FACE_UNUSED))
+                        {
+                            wchar_t buff[128] = {};
+                            swprintf_s(buff, L"An unused face (%zu) contains 'valid' but ignored vertices (%u,%u,%u)\n", face, i0, i1, i2);
+                            *msgs += buff;
+                        }
                     }
 
                     if (adjacency)
@@ -136,9 +298,12 @@ namespace
 
                                 result = false;
 
-                                wchar_t buff[128] = {};
-                                swprintf_s(buff, L"An unused face (%zu) has a neighbor %u\n", face, k);
-                                *msgs += buff;
+                                if (describe(FACE_UNUSED))
+                                {
+                                    wchar_t buff[128] = {};
+                                    swprintf_s(buff, L"An unused face (%zu) has a neighbor %u\n", face, k);
+                                    *msgs += buff;
+                                }
                             }
                         }
                     }
@@ -168,21 +333,24 @@ namespace
                     else
                         bad = i0;
 
-                    wchar_t buff[128] = {};
-                    swprintf_s(buff, L"A point (%u) was found more than once in triangle %zu\n", bad, face);
-                    *msgs += buff;
-
-                    if (adjacency)
+                    if (describe(FACE_DEGENERATE))
                     {
-                        for (size_t point = 0; point < 3; ++point)
+                        wchar_t buff[128] = {};
+                        swprintf_s(buff, L"A point (%u) was found more than once in triangle %zu\n", bad, face);
+                        *msgs += buff;
+
+                        if (adjacency)
                         {
-                            const uint32_t k = adjacency[face * 3 + point];
-                            if (k != UNUSED32)
+                            for (size_t point = 0; point < 3; ++point)
                             {
-                                result = false;
-
-                                swprintf_s(buff, L"A degenerate face (%zu) has a neighbor %u\n", face, k);
-                                *msgs += buff;
+                                const uint32_t k = adjacency[face * 3 + point];
+                                if (k != UNUSED32)
+                                {
+                                    result = false;
+
+                                    swprintf_s(buff, L"A degenerate face (%zu) has a neighbor %u\n", face, k);
+                                    *msgs += buff;
+                                }
                             }
                         }
                     }
@@ -211,9 +379,12 @@ namespace
 
                         result = false;
 
-                        wchar_t buff[256] = {};
-                        swprintf_s(buff, L"A neighbor triangle (%u) does not reference back to this face (%zu) as expected\n", k, face);
-                        *msgs += buff;
+                        if (describe(FACE_ASYMMETRIC_ADJ))
+                        {
+                            wchar_t buff[256] = {};
+                            swprintf_s(buff, L"A neighbor triangle (%u) does not reference back to this face (%zu) as expected\n", k, face);
+                            *msgs += buff;
+                        }
                     }
                 }
             }
@@ -234,18 +405,21 @@ namespace
 
                     result = false;
 
-                    uint32_t bad;
-                    if (j0 == j1 && j0 != UNUSED32)
-                        bad = j0;
-                    else if (j0 == j2 && j0 != UNUSED32)
-                        bad = j0;
-                    else
-                        bad = j1;
+                    if (describe(FACE_BACKFACING))
+                    {
+                        uint32_t bad;
+                        if (j0 == j1 && j0 != UNUSED32)
+                            bad = j0;
+                        else if (j0 == j2 && j0 != UNUSED32)
+                            bad = j0;
+                        else
+                            bad = j1;
 
-                    wchar_t buff[256] = {};
-                    swprintf_s(buff, L"A neighbor triangle (%u) was found more than once on triangle %zu\n"
-                        L"\t(likley problem is that two triangles share same points with opposite direction)\n", bad, face);
-                    *msgs += buff;
+                        wchar_t buff[256] = {};
+                        swprintf_s(buff, L"A neighbor triangle (%u) was found more than once on triangle %zu\n"
+                            L"\t(likley problem is that two triangles share same points with opposite direction)\n", bad, face);
+                        *msgs += buff;
+                    }
                 }
             }
         }
@@ -255,23 +429,15 @@ namespace
 
 
     //---------------------------------------------------------------------------------
-    // Validates mesh contains no bowties
-    // (i.e. a vertex is the apex of two separate triangle fans)
+    // Finds each bowtie (i.e. a vertex is the apex of two separate triangle fans),
+    // calling found(vertex, face, otherFace) once per vertex until it returns false
     //---------------------------------------------------------------------------------
-    template<class index_t>
-    HRESULT ValidateNoBowties(
+    template<class index_t, class Found>
+    HRESULT FindBowties(
         _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
-        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
-        _In_opt_ std::wstring* msgs)
+        _In_ size_t nVerts, _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        Found&& found)
     {
-        if (!adjacency)
-        {
-            if (msgs)
-                *msgs += L"Missing adjacency information required to check for BOWTIES\n";
-
-            return E_INVALIDARG;
-        }
-
         const size_t tsize = (sizeof(bool) * nFaces * 3) + (sizeof(index_t) * nVerts * 2) + (sizeof(bool) * nVerts);
         std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[tsize]);
         if (!temp)
@@ -289,19 +455,20 @@ namespace
 
         orbit_iterator<index_t> ovi(adjacency, indices, nFaces);
 
-        bool result = true;
-
         for (uint32_t face = 0; face < nFaces; ++face)
         {
             index_t i0 = indices[face * 3];
             index_t i1 = indices[face * 3 + 1];
             index_t i2 = indices[face * 3 + 2];
 
-            if (i0 == i1
+            if (i0 == index_t(-1)
+                || i1 == index_t(-1)
+                || i2 == index_t(-1)
+                || i0 == i1
                 || i0 == i2
                 || i1 == i2)
             {
-                // ignore degenerate faces
+                // ignore unused and degenerate faces
                 faceSeen[face * 3] = true;
                 faceSeen[face * 3 + 1] = true;
                 faceSeen[face * 3 + 2] = true;
@@ -331,6 +498,8 @@ namespace
                     faceSeen[curFace * 3 + curPoint] = true;
 
                     uint32_t j = indices[curFace * 3 + curPoint];
+                    if (j == index_t(-1))
+                        continue;
 
                     if (faceIds[j] == index_t(-1))
                     {
@@ -340,30 +509,378 @@ namespace
                     else if ((faceIds[j] != index_t(face)) && !vertexBowtie[j])
                     {
                         // We found a (unique) bowtie!
+                        vertexBowtie[j] = true;
 
-                        if (!msgs)
-                            return E_FAIL;
+                        if (!found(j, curFace, uint32_t(faceUsing[j])))
+                            return S_OK;
+                    }
+                }
+            }
+        }
 
-                        if (result)
-                        {
-                            // If this is the first bowtie found, add a quick explanation
-                            *msgs += L"A bowtie was found.  Bowties can be fixed by calling Clean\n"
-                                L"  A bowtie is the usage of a single vertex by two separate fans of triangles.\n"
-                                L"  The fix is to duplicate the vertex so that each fan has its own vertex.\n";
-                            result = false;
-                        }
+        return S_OK;
+    }
 
-                        vertexBowtie[j] = true;
 
-                        wchar_t buff[256] = {};
-                        swprintf_s(buff, L"\nBowtie found around vertex %u shared by faces %u and %u\n", j, curFace, faceUsing[j]);
-                        *msgs += buff;
+    //---------------------------------------------------------------------------------
+    // Validates mesh contains no bowties
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ValidateNoBowties(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ VALIDATE_FLAGS flags, _In_opt_ std::wstring* msgs)
+    {
+        if (!adjacency)
+        {
+            if (msgs)
+                *msgs += L"Missing adjacency information required to check for BOWTIES\n";
+
+            return E_INVALIDARG;
+        }
+
+        bool result = true;
+
+        HRESULT hr = FindBowties<index_t>(indices, nFaces, nVerts, adjacency,
+            [&](uint32_t vertex, uint32_t face, uint32_t otherFace) -> bool
+            {
+                if (!msgs)
+                {
+                    result = false;
+                    return false;
+                }
+
+                if (result)
+                {
+                    // If this is the first bowtie found, add a quick explanation
+                    *msgs += L"A bowtie was found.  Bowties can be fixed by calling Clean\n"
+                        L"  A bowtie is the usage of a single vertex by two separate fans of triangles.\n"
+                        L"  The fix is to duplicate the vertex so that each fan has its own vertex.\n";
+                    result = false;
+                }
+
+                wchar_t buff[256] = {};
+                swprintf_s(buff, L"\nBowtie found around vertex %u shared by faces %u and %u\n", vertex, face, otherFace);
+                *msgs += buff;
+                return !(flags & VALIDATE_QUICK);
+            });
+        if (FAILED(hr))
+            return hr;
+
+        return result ? S_OK : E_FAIL;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Counts the problems found by Validate per class, checking faces in parallel and
+    // then listing the first maxFaces offending faces in face order
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ValidateStatsImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ VALIDATE_FLAGS flags, _Out_ ValidateStats& stats,
+        _Out_writes_opt_(maxFaces) uint32_t* faces, _In_ size_t maxFaces) noexcept
+    {
+        if (maxFaces > 0 && !faces)
+            return E_INVALIDARG;
+
+        if (!adjacency && (flags & (VALIDATE_BACKFACING | VALIDATE_BOWTIES | VALIDATE_ASYMMETRIC_ADJ)))
+            return E_INVALIDARG;
+
+        const int count = static_cast<int>((nFaces + c_BlockSize - 1) / c_BlockSize);
+
+        // Asymmetric neighbors are always found when checking bowties, but only reported if requested
+        const uint32_t reportMask = (flags & VALIDATE_ASYMMETRIC_ADJ) ? ~0u : ~uint32_t(FACE_ASYMMETRIC_ADJ);
+
+        // A quick check stops once every requested class has been found, or at the first out-of-range value.
+        // The bowtie walk also needs every face checked for asymmetric neighbors, unless one is found and the walk is skipped.
+        const bool quick = (flags & VALIDATE_QUICK) != 0;
+        const uint32_t requested = RequestedIssues(flags, adjacency != nullptr);
+        const bool bowties = (flags & VALIDATE_BOWTIES) != 0;
+        auto finished = [requested, bowties](uint32_t found) noexcept -> bool
+            {
+                if (found & FACE_INVALID_INDEX)
+                    return true;
+
+                return requested && (found & requested) == requested
+                    && (!bowties || (found & FACE_ASYMMETRIC_ADJ));
+            };
+
+        std::unique_ptr<ValidateStats[]> blockStats(new (std::nothrow) ValidateStats[size_t(count)]);
+        if (!blockStats)
+            return E_OUTOFMEMORY;
+
+        uint32_t found = 0;
+        int checked = 0;
+        while (checked < count && !(quick && finished(found)))
+        {
+            const int first = checked;
+            const int last = quick ? std::min(first + c_QuickWave, count) : count;
+
+        #ifdef _OPENMP
+        #pragma omp parallel for if ((last - first) > 1)
+        #endif
+            for (int block = first; block < last; ++block)
+            {
+                const size_t start = size_t(block) * c_BlockSize;
+                const size_t end = std::min(start + c_BlockSize, nFaces);
+
+                ValidateStats& bs = blockStats[block];
+                bs = {};
+
+                uint32_t blockFound = 0;
+                for (size_t face = start; face < end; ++face)
+                {
+                    uint32_t issues = CheckFace<index_t>(indices, nFaces, nVerts, adjacency, flags, face);
+                    if (quick)
+                    {
+                        // Only the first face of each class in the block is counted
+                        issues &= ~blockFound;
                     }
+
+                    if (!issues)
+                        continue;
+
+                    blockFound |= issues;
+
+                    if (issues & FACE_INVALID_INDEX)
+                        ++bs.InvalidIndices;
+
+                    if (issues & FACE_UNUSED)
+                        ++bs.Unused;
+
+                    if (issues & FACE_DEGENERATE)
+                        ++bs.Degenerate;
+
+                    if (issues & FACE_BACKFACING)
+                        ++bs.Backfacing;
+
+                    if (issues & FACE_ASYMMETRIC_ADJ)
+                        ++bs.AsymmetricAdj;
+
+                    if (issues & reportMask)
+                        ++bs.FaceCount;
+
+                    if (quick && finished(blockFound))
+                        break;
                 }
             }
+
+            for (int block = first; block < last; ++block)
+            {
+                const ValidateStats& bs = blockStats[block];
+                found |= (bs.InvalidIndices ? uint32_t(FACE_INVALID_INDEX) : 0u)
+                    | (bs.Unused ? uint32_t(FACE_UNUSED) : 0u)
+                    | (bs.Degenerate ? uint32_t(FACE_DEGENERATE) : 0u)
+                    | (bs.Backfacing ? uint32_t(FACE_BACKFACING) : 0u)
+                    | (bs.AsymmetricAdj ? uint32_t(FACE_ASYMMETRIC_ADJ) : 0u);
+            }
+
+            checked = last;
         }
 
-        return result ? S_OK : E_FAIL;
+        // FaceCount becomes each block's offset into the list of offending faces
+        size_t offending = 0;
+        for (int block = 0; block < checked; ++block)
+        {
+            ValidateStats& bs = blockStats[block];
+            stats.InvalidIndices += bs.InvalidIndices;
+            stats.Unused += bs.Unused;
+            stats.Degenerate += bs.Degenerate;
+            stats.Backfacing += bs.Backfacing;
+            stats.AsymmetricAdj += bs.AsymmetricAdj;
+
+            const size_t n = bs.FaceCount;
+            bs.FaceCount = offending;
+            offending += n;
+        }
+
+        const bool asymmetric = (stats.AsymmetricAdj > 0);
+        if (!(flags & VALIDATE_ASYMMETRIC_ADJ))
+        {
+            stats.AsymmetricAdj = 0;
+        }
+
+        if (quick)
+        {
+            // Report the first face of each class found, in face order
+            const uint32_t reported = found & reportMask;
+            uint32_t listed = 0;
+            size_t nFirst = 0;
+            for (size_t face = 0; face < nFaces && listed != reported && nFirst < maxFaces; ++face)
+            {
+                const uint32_t issues = CheckFace<index_t>(indices, nFaces, nVerts, adjacency, flags, face) & reported & ~listed;
+                if (issues)
+                {
+                    listed |= issues;
+                    faces[nFirst++] = uint32_t(face);
+                }
+            }
+
+            stats.InvalidIndices = std::min<size_t>(stats.InvalidIndices, 1);
+            stats.Unused = std::min<size_t>(stats.Unused, 1);
+            stats.Degenerate = std::min<size_t>(stats.Degenerate, 1);
+            stats.Backfacing = std::min<size_t>(stats.Backfacing, 1);
+            stats.AsymmetricAdj = std::min<size_t>(stats.AsymmetricAdj, 1);
+
+            stats.FaceCount = nFirst;
+        }
+        else
+        {
+            stats.FaceCount = std::min(offending, maxFaces);
+        }
+
+        if (!quick && stats.FaceCount > 0)
+        {
+        #ifdef _OPENMP
+        #pragma omp parallel for if (count > 1)
+        #endif
+            for (int block = 0; block < count; ++block)
+            {
+                size_t offset = blockStats[block].FaceCount;
+                if (offset >= maxFaces)
+                    continue;
+
+                const size_t start = size_t(block) * c_BlockSize;
+                const size_t end = std::min(start + c_BlockSize, nFaces);
+
+                for (size_t face = start; face < end && offset < maxFaces; ++face)
+                {
+                    if (CheckFace<index_t>(indices, nFaces, nVerts, adjacency, flags, face) & reportMask)
+                        faces[offset++] = uint32_t(face);
+                }
+            }
+        }
+
+        // Fans can't be walked safely through out-of-range values or asymmetric neighbors
+        if ((flags & VALIDATE_BOWTIES) && !stats.InvalidIndices && !asymmetric)
+        {
+            HRESULT hr = FindBowties<index_t>(indices, nFaces, nVerts, adjacency,
+                [&](uint32_t, uint32_t face, uint32_t) noexcept -> bool
+                {
+                    ++stats.Bowties;
+
+                    if (stats.FaceCount < maxFaces)
+                        faces[stats.FaceCount++] = face;
+
+                    return !quick;
+                });
+            if (FAILED(hr))
+                return hr;
+        }
+
+        if (stats.InvalidIndices || stats.Unused || stats.Degenerate
+            || stats.Backfacing || stats.AsymmetricAdj || stats.Bowties)
+            return E_FAIL;
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Checks a range of faces for out-of-range indices. The indices are scanned as a flat
+    // array with no branches so the compiler can vectorize the loop.
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    bool ScanIndices(
+        _In_reads_(end * 3) const index_t* indices, size_t start, size_t end,
+        size_t nVerts) noexcept
+    {
+        constexpr uint32_t c_Unused = index_t(-1);
+        const auto limit = static_cast<uint32_t>(nVerts);
+
+        uint32_t bad = 0;
+        for (size_t j = start * 3; j < end * 3; ++j)
+        {
+            const uint32_t i = indices[j];
+            bad |= uint32_t(i >= limit) & uint32_t(i != c_Unused);
+        }
+
+        return bad != 0;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Checks a range of faces for degenerate or partially unused faces without branching
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    bool ScanFaces(
+        _In_reads_(end * 3) const index_t* indices, size_t start, size_t end,
+        uint32_t degenerate, uint32_t unused) noexcept
+    {
+        constexpr uint32_t c_Unused = index_t(-1);
+
+        uint32_t bad = 0;
+        for (size_t face = start; face < end; ++face)
+        {
+            const uint32_t i0 = indices[face * 3];
+            const uint32_t i1 = indices[face * 3 + 1];
+            const uint32_t i2 = indices[face * 3 + 2];
+
+            const uint32_t u0 = uint32_t(i0 == c_Unused);
+            const uint32_t u1 = uint32_t(i1 == c_Unused);
+            const uint32_t u2 = uint32_t(i2 == c_Unused);
+            const uint32_t anyUnused = u0 | u1 | u2;
+
+            bad |= anyUnused & ((u0 & u1 & u2) ^ 1) & unused;
+            bad |= (uint32_t(i0 == i1) | uint32_t(i0 == i2) | uint32_t(i1 == i2)) & (anyUnused ^ 1) & degenerate;
+        }
+
+        return bad != 0;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Checks indices without adjacency, stopping at the first problem found
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ValidateIBImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_ VALIDATE_FLAGS flags) noexcept
+    {
+        // Blocks are scanned in chunks so a problem near the start of a block ends it early
+        constexpr size_t c_ChunkSize = 256;
+
+        const uint32_t degenerate = (flags & VALIDATE_DEGENERATE) ? 1u : 0u;
+        const uint32_t unused = (flags & VALIDATE_UNUSED) ? 1u : 0u;
+
+        const int count = static_cast<int>((nFaces + c_BlockSize - 1) / c_BlockSize);
+
+        // Blocks are checked a wave at a time, stopping after the wave with the first problem
+        for (int first = 0; first < count; first += c_QuickWave)
+        {
+            const int last = std::min(first + c_QuickWave, count);
+
+            bool failed[c_QuickWave] = {};
+
+        #ifdef _OPENMP
+        #pragma omp parallel for if ((last - first) > 1)
+        #endif
+            for (int block = first; block < last; ++block)
+            {
+                const size_t start = size_t(block) * c_BlockSize;
+                const size_t end = std::min(start + c_BlockSize, nFaces);
+
+                for (size_t chunk = start; chunk < end; chunk += c_ChunkSize)
+                {
+                    const size_t chunkEnd = std::min(chunk + c_ChunkSize, end);
+                    if (ScanIndices<index_t>(indices, chunk, chunkEnd, nVerts)
+                        || ((degenerate | unused) && ScanFaces<index_t>(indices, chunk, chunkEnd, degenerate, unused)))
+                    {
+                        failed[block - first] = true;
+                        break;
+                    }
+                }
+            }
+
+            for (int j = 0; j < (last - first); ++j)
+            {
+                if (failed[j])
+                    return E_FAIL;
+            }
+        }
+
+        return S_OK;
     }
 }
 
@@ -399,7 +916,7 @@ HRESULT DirectX::Validate(
 
     if (flags & VALIDATE_BOWTIES)
     {
-        hr = ValidateNoBowties<uint16_t>(indices, nFaces, nVerts, adjacency, msgs);
+        hr = ValidateNoBowties<uint16_t>(indices, nFaces, nVerts, adjacency, flags, msgs);
         if (FAILED(hr))
             return hr;
     }
@@ -436,10 +953,106 @@ HRESULT DirectX::Validate(
 
     if (flags & VALIDATE_BOWTIES)
     {
-        hr = ValidateNoBowties<uint32_t>(indices, nFaces, nVerts, adjacency, msgs);
+        hr = ValidateNoBowties<uint32_t>(indices, nFaces, nVerts, adjacency, flags, msgs);
         if (FAILED(hr))
             return hr;
     }
 
     return S_OK;
 }
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::Validate(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    VALIDATE_FLAGS flags,
+    ValidateStats& stats,
+    uint32_t* faces,
+    size_t maxFaces) noexcept
+{
+    stats = {};
+
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT16_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return ValidateStatsImpl<uint16_t>(indices, nFaces, nVerts, adjacency, flags, stats, faces, maxFaces);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::Validate(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    VALIDATE_FLAGS flags,
+    ValidateStats& stats,
+    uint32_t* faces,
+    size_t maxFaces) noexcept
+{
+    stats = {};
+
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return ValidateStatsImpl<uint32_t>(indices, nFaces, nVerts, adjacency, flags, stats, faces, maxFaces);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ValidateIB(
+    const uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    VALIDATE_FLAGS flags) noexcept
+{
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT16_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return ValidateIBImpl<uint16_t>(indices, nFaces, nVerts, flags);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ValidateIB(
+    const uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    VALIDATE_FLAGS flags) noexcept
+{
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return ValidateIBImpl<uint32_t>(indices, nFaces, nVerts, flags);
+}
@@ -15,6 +15,8 @@ using namespace DirectX;
 
 namespace
 {
+    constexpr size_t c_BlockSize = 4096;
+
     template<class index_t>
     HRESULT WeldVerticesImpl(
         _Inout_updates_all_(nFaces * 3) index_t* indices, size_t nFaces,
@@ -142,6 +144,426 @@ namespace
 
         return S_OK;
     }
+
+
+    //---------------------------------------------------------------------------------
+    // Vertex attributes and tolerances for the built-in welder. Positions are hashed
+    // on a grid with cells four times as wide as the position tolerance, so a match lies
+    // in the vertex's own cell or across a cell face it is within tolerance of, and on
+    // average about four cells are searched. A zero tolerance uses the exact
+    // position as the cell, so only the vertex's own cell is searched.
+    //---------------------------------------------------------------------------------
+    class weld_context
+    {
+    public:
+        weld_context(const WeldVertexData& vertices, const WeldTolerances& tolerances, size_t nVerts) noexcept :
+            mVertices(vertices),
+            mPositionSq(tolerances.Position * tolerances.Position),
+            mExactPosition(!(tolerances.Position > 0.f)),
+            mExactNormal(!(tolerances.NormalAngle > 0.f)),
+            mCosNormal(std::cos(std::min(tolerances.NormalAngle, XM_PI))),
+            mTexCoordSq(tolerances.TexCoord * tolerances.TexCoord),
+            mColor(tolerances.Color),
+            mInvCell(mExactPosition ? 0.f : (1.f / (c_CellScale * tolerances.Position))),
+            mMask(0)
+        {
+            size_t tableSize = 1;
+            while (tableSize < nVerts)
+                tableSize <<= 1;
+
+            mMask = static_cast<uint32_t>(tableSize - 1);
+
+            if (!mVertices.PositionStride)
+                mVertices.PositionStride = sizeof(XMFLOAT3);
+            if (!mVertices.NormalStride)
+                mVertices.NormalStride = sizeof(XMFLOAT3);
+            if (!mVertices.TexCoordStride)
+                mVertices.TexCoordStride = sizeof(XMFLOAT2);
+            if (!mVertices.ColorStride)
+                mVertices.ColorStride = sizeof(XMFLOAT4);
+        }
+
+        static constexpr float c_CellScale = 4.f;
+
+        size_t tablesize() const noexcept { return size_t(mMask) + 1; }
+
+        // Returns the cell of a vertex, with a bit per axis (0x1-0x4) set if the vertex is within
+        // tolerance of a neighboring cell, and a bit per axis (0x8-0x20) set if that neighbor is above
+        uint32_t cell(uint32_t v, _Out_writes_(3) int32_t* c) const noexcept
+        {
+            const XMFLOAT3& p = element(mVertices.Positions, mVertices.PositionStride, v);
+            const float f[3] = { p.x, p.y, p.z };
+
+            uint32_t nearby = 0;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                if (mExactPosition)
+                {
+                    // Adding zero turns -0 into +0 so equal positions share a cell
+                    const float x = f[j] + 0.f;
+                    memcpy(&c[j], &x, sizeof(int32_t));
+                }
+                else
+                {
+                    // Selects rather than branches, as vertices are often visited in random order
+                    constexpr float c_MaxCell = 1073741824.f;
+
+                    const float x = f[j] * mInvCell;
+                    float fx = std::floor(x);
+                    fx = (fx > -c_MaxCell) ? fx : -c_MaxCell;
+                    fx = (fx < c_MaxCell) ? fx : c_MaxCell;
+
+                    c[j] = static_cast<int32_t>(fx);
+
+                    // The tolerance is a quarter of a cell, plus some slack for rounding
+                    constexpr float c_Near = 1.25f / c_CellScale;
+
+                    const float frac = x - fx;
+                    nearby |= uint32_t(frac < c_Near) << j;
+                    nearby |= uint32_t(frac > (1.f - c_Near)) * (0x9u << j);
+                }
+            }
+
+            return nearby;
+        }
+
+        // Returns the cell searched by a probe, stepping to the neighboring cell on each axis in the probe's mask
+        static void probe(_In_reads_(3) const int32_t* c, uint32_t nearby, uint32_t mask, _Out_writes_(3) int32_t* pc) noexcept
+        {
+            for (uint32_t j = 0; j < 3; ++j)
+            {
+                pc[j] = c[j];
+                if (mask & (1u << j))
+                {
+                    pc[j] += (nearby & (0x8u << j)) ? 1 : -1;
+                }
+            }
+        }
+
+        uint32_t bucket(_In_reads_(3) const int32_t* c) const noexcept
+        {
+            uint32_t h = (uint32_t(c[0]) * 0x8da6b343u) ^ (uint32_t(c[1]) * 0xd8163841u) ^ (uint32_t(c[2]) * 0xcb1ab31fu);
+            h ^= h >> 15;
+            h *= 0x2c1b3c6du;
+            h ^= h >> 12;
+            return h & mMask;
+        }
+
+        bool matches(uint32_t a, uint32_t b) const noexcept
+        {
+            const XMFLOAT3& pa = element(mVertices.Positions, mVertices.PositionStride, a);
+            const XMFLOAT3& pb = element(mVertices.Positions, mVertices.PositionStride, b);
+            if (mExactPosition)
+            {
+                if (pa.x != pb.x || pa.y != pb.y || pa.z != pb.z)
+                    return false;
+            }
+            else
+            {
+                const float dx = pa.x - pb.x;
+                const float dy = pa.y - pb.y;
+                const float dz = pa.z - pb.z;
+                if (!((dx * dx + dy * dy + dz * dz) <= mPositionSq))
+                    return false;
+            }
+
+            if (mVertices.Normals)
+            {
+                const XMFLOAT3& na = element(mVertices.Normals, mVertices.NormalStride, a);
+                const XMFLOAT3& nb = element(mVertices.Normals, mVertices.NormalStride, b);
+                if (mExactNormal)
+                {
+                    if (na.x != nb.x || na.y != nb.y || na.z != nb.z)
+                        return false;
+                }
+                else
+                {
+                    const float d = na.x * nb.x + na.y * nb.y + na.z * nb.z;
+                    const float la = na.x * na.x + na.y * na.y + na.z * na.z;
+                    const float lb = nb.x * nb.x + nb.y * nb.y + nb.z * nb.z;
+                    if (!(d >= mCosNormal * std::sqrt(la * lb)))
+                        return false;
+                }
+            }
+
+            if (mVertices.TexCoords)
+            {
+                const XMFLOAT2& ta = element(mVertices.TexCoords, mVertices.TexCoordStride, a);
+                const XMFLOAT2& tb = element(mVertices.TexCoords, mVertices.TexCoordStride, b);
+                const float du = ta.x - tb.x;
+                const float dv = ta.y - tb.y;
+                if (!((du * du + dv * dv) <= mTexCoordSq))
+                    return false;
+            }
+
+            if (mVertices.Colors)
+            {
+                const XMFLOAT4& ca = element(mVertices.Colors, mVertices.ColorStride, a);
+                const XMFLOAT4& cb = element(mVertices.Colors, mVertices.ColorStride, b);
+                if (!(std::abs(ca.x - cb.x) <= mColor)
+                    || !(std::abs(ca.y - cb.y) <= mColor)
+                    || !(std::abs(ca.z - cb.z) <= mColor)
+                    || !(std::abs(ca.w - cb.w) <= mColor))
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        template<class T>
+        static const T& element(const T* base, size_t stride, size_t index) noexcept
+        {
+            return *reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(base) + stride * index);
+        }
+
+        WeldVertexData  mVertices;
+        float           mPositionSq;
+        bool            mExactPosition;
+        bool            mExactNormal;
+        float           mCosNormal;
+        float           mTexCoordSq;
+        float           mColor;
+        float           mInvCell;
+        uint32_t        mMask;
+    };
+
+
+    //---------------------------------------------------------------------------------
+    // Vertices grouped by hash bucket in ascending order, with the cell of each entry
+    // stored alongside so vertices in other cells are skipped without being read
+    //---------------------------------------------------------------------------------
+    struct weld_table
+    {
+        const uint32_t* bucketStart;
+        const uint32_t* bucketVerts;
+        const int32_t*  bucketCells;
+    };
+
+    // Returns the lowest numbered vertex before v which matches it and is accepted, or v
+    template<class Accept>
+    uint32_t FindWeld(
+        const weld_context& context, const weld_table& table,
+        uint32_t v, _In_reads_(3) const int32_t* c, uint32_t nearby, Accept&& accept) noexcept
+    {
+        // Look up every cell before scanning any, so the table reads can overlap
+        int32_t cells[8][3];
+        uint32_t begin[8];
+        uint32_t end[8];
+        uint32_t nCells = 0;
+
+        for (uint32_t mask = 0; mask < 8; ++mask)
+        {
+            if (mask & ~nearby)
+                continue;
+
+            weld_context::probe(c, nearby, mask, cells[nCells]);
+            begin[nCells] = context.bucket(cells[nCells]);
+            ++nCells;
+        }
+
+        for (uint32_t k = 0; k < nCells; ++k)
+        {
+            const uint32_t b = begin[k];
+            begin[k] = table.bucketStart[b];
+            end[k] = table.bucketStart[b + 1];
+        }
+
+        uint32_t best = v;
+
+        for (uint32_t k = 0; k < nCells; ++k)
+        {
+            const int32_t* pc = cells[k];
+            for (uint32_t j = begin[k]; j < end[k]; ++j)
+            {
+                const uint32_t u = table.bucketVerts[j];
+                if (u >= best)
+                    break;
+
+                const int32_t* uc = &table.bucketCells[size_t(j) * 3];
+                if (uc[0] != pc[0] || uc[1] != pc[1] || uc[2] != pc[2])
+                    continue;
+
+                if (accept(u) && context.matches(u, v))
+                {
+                    best = u;
+                    break;
+                }
+            }
+        }
+
+        return best;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT WeldVerticesSpatialImpl(
+        _Inout_updates_all_(nFaces * 3) index_t* indices, size_t nFaces,
+        size_t nVerts, const WeldVertexData& vertices, const WeldTolerances& tolerances,
+        _Out_writes_opt_(nVerts) uint32_t* vertexRemap) noexcept
+    {
+        if (!vertices.Positions)
+            return E_INVALIDARG;
+
+        if (!(tolerances.Position >= 0.f) || !(tolerances.NormalAngle >= 0.f)
+            || !(tolerances.TexCoord >= 0.f) || !(tolerances.Color >= 0.f))
+            return E_INVALIDARG;
+
+        for (size_t j = 0; j < nFaces * 3; ++j)
+        {
+            const index_t i = indices[j];
+            if (i != index_t(-1) && i >= nVerts)
+                return E_UNEXPECTED;
+        }
+
+        if (vertexRemap)
+        {
+            for (uint32_t j = 0; j < nVerts; ++j)
+            {
+                vertexRemap[j] = j;
+            }
+        }
+
+        // The hash table has fewer than twice as many buckets as there are vertices
+        if ((uint64_t(nVerts) * 10 + 1) >= (SIZE_MAX / sizeof(uint32_t)))
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        const weld_context context(vertices, tolerances, nVerts);
+        const size_t tableSize = context.tablesize();
+
+        std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nVerts * 8 + tableSize + 1]);
+        std::unique_ptr<uint8_t[]> flags(new (std::nothrow) uint8_t[nVerts * 2]);
+        if (!temp || !flags)
+            return E_OUTOFMEMORY;
+
+        auto vertexRemapInverse = temp.get();
+        auto vertexCells = reinterpret_cast<int32_t*>(vertexRemapInverse + nVerts);
+        auto bucketCells = vertexCells + nVerts * 3;
+        auto bucketVerts = reinterpret_cast<uint32_t*>(bucketCells + nVerts * 3);
+        auto bucketStart = bucketVerts + nVerts;
+        auto vertexFlags = flags.get();
+        auto bucketFlags = vertexFlags + nVerts;
+
+        const int count = static_cast<int>((nVerts + c_BlockSize - 1) / c_BlockSize);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nVerts);
+
+            for (size_t v = start; v < end; ++v)
+            {
+                vertexFlags[v] = static_cast<uint8_t>(context.cell(uint32_t(v), &vertexCells[v * 3]));
+            }
+        }
+
+        // Counting sort by bucket keeps each bucket's vertices in ascending order, with their cells alongside
+        memset(bucketStart, 0, sizeof(uint32_t) * (tableSize + 1));
+
+        for (size_t v = 0; v < nVerts; ++v)
+        {
+            ++bucketStart[context.bucket(&vertexCells[v * 3]) + 1];
+        }
+
+        for (size_t j = 1; j <= tableSize; ++j)
+        {
+            bucketStart[j] += bucketStart[j - 1];
+        }
+
+        for (uint32_t v = 0; v < nVerts; ++v)
+        {
+            const int32_t* c = &vertexCells[size_t(v) * 3];
+            const uint32_t j = bucketStart[context.bucket(c)]++;
+            bucketVerts[j] = v;
+            bucketCells[size_t(j) * 3] = c[0];
+            bucketCells[size_t(j) * 3 + 1] = c[1];
+            bucketCells[size_t(j) * 3 + 2] = c[2];
+            bucketFlags[j] = vertexFlags[v];
+        }
+
+        for (size_t j = tableSize; j > 0; --j)
+        {
+            bucketStart[j] = bucketStart[j - 1];
+        }
+        bucketStart[0] = 0;
+
+        const weld_table table = { bucketStart, bucketVerts, bucketCells };
+
+        // Find the first earlier vertex which matches each vertex, visiting them in bucket order
+    #ifdef _OPENMP
+    #pragma omp parallel for if (count > 1)
+    #endif
+        for (int block = 0; block < count; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nVerts);
+
+            for (size_t j = start; j < end; ++j)
+            {
+                const uint32_t v = bucketVerts[j];
+                vertexRemapInverse[v] = FindWeld(context, table, v, &bucketCells[j * 3], bucketFlags[j],
+                    [](uint32_t) noexcept { return true; });
+            }
+        }
+
+        // A vertex can only weld to a vertex which was kept, so search again when the first match was itself welded
+        bool weld = false;
+
+        for (uint32_t v = 0; v < nVerts; ++v)
+        {
+            const uint32_t u = vertexRemapInverse[v];
+            if (u == v)
+                continue;
+
+            if (vertexRemapInverse[u] != u)
+            {
+                vertexRemapInverse[v] = FindWeld(context, table, v, &vertexCells[size_t(v) * 3], vertexFlags[v],
+                    [vertexRemapInverse](uint32_t w) noexcept { return vertexRemapInverse[w] == w; });
+            }
+
+            if (vertexRemapInverse[v] != v)
+                weld = true;
+        }
+
+        if (!weld)
+            return S_FALSE;
+
+        // Apply map to indices
+        const int indexCount = static_cast<int>((nFaces * 3 + c_BlockSize - 1) / c_BlockSize);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for if (indexCount > 1)
+    #endif
+        for (int block = 0; block < indexCount; ++block)
+        {
+            const size_t start = size_t(block) * c_BlockSize;
+            const size_t end = std::min(start + c_BlockSize, nFaces * 3);
+
+            for (size_t j = start; j < end; ++j)
+            {
+                const index_t i = indices[j];
+                if (i != index_t(-1))
+                    indices[j] = index_t(vertexRemapInverse[i]);
+            }
+        }
+
+        // Generate inverse map if requested
+        if (vertexRemap)
+        {
+            memset(vertexRemap, 0xff, sizeof(uint32_t) * nVerts);
+
+            for (uint32_t j = 0; j < nVerts; ++j)
+            {
+                vertexRemap[vertexRemapInverse[j]] = j;
+            }
+        }
+
+        return S_OK;
+    }
 }
 
 //=====================================================================================
@@ -187,3 +609,47 @@ HRESULT DirectX::WeldVertices(
 
     return WeldVerticesImpl<uint32_t>(indices, nFaces, nVerts, pointRep, vertexRemap, weldTest);
 }
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::WeldVertices(
+    uint16_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const WeldVertexData& vertices,
+    const WeldTolerances& tolerances,
+    uint32_t* vertexRemap) noexcept
+{
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT16_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return WeldVerticesSpatialImpl<uint16_t>(indices, nFaces, nVerts, vertices, tolerances, vertexRemap);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::WeldVertices(
+    uint32_t* indices,
+    size_t nFaces,
+    size_t nVerts,
+    const WeldVertexData& vertices,
+    const WeldTolerances& tolerances,
+    uint32_t* vertexRemap) noexcept
+{
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+    return WeldVerticesSpatialImpl<uint32_t>(indices, nFaces, nVerts, vertices, tolerances, vertexRemap);
+}
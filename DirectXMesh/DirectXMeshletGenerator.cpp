@@ -726,6 +726,993 @@ namespace
 
         return S_OK;
     }
+
+    //---------------------------------------------------------------------------------
+    // Collects the quality statistics used to rank candidate meshlet sizes
+    //---------------------------------------------------------------------------------
+    template <typename T>
+    void ComputeMeshletStats(
+        const std::vector<Meshlet>& meshlets,
+        const std::vector<uint8_t>& uniqueVertexIB,
+        const std::vector<CullData>& cullData,
+        size_t nVerts,
+        size_t maxVerts,
+        size_t maxPrims,
+        MeshletStats& stats)
+    {
+        stats.MaxVerts = maxVerts;
+        stats.MaxPrims = maxPrims;
+        stats.MeshletCount = meshlets.size();
+        stats.VertexDuplication = 0.f;
+        stats.VertexFill = 0.f;
+        stats.PrimitiveFill = 0.f;
+        stats.ConeCullRate = 0.f;
+
+        if (meshlets.empty())
+            return;
+
+        auto vertIndices = reinterpret_cast<const T*>(uniqueVertexIB.data());
+        const size_t nVertIndices = uniqueVertexIB.size() / sizeof(T);
+
+        std::vector<bool> used;
+        used.resize(nVerts);
+
+        size_t distinct = 0;
+        for (size_t j = 0; j < nVertIndices; ++j)
+        {
+            const T v = vertIndices[j];
+            if (v < nVerts && !used[v])
+            {
+                used[v] = true;
+                ++distinct;
+            }
+        }
+
+        size_t totalVerts = 0;
+        size_t totalPrims = 0;
+        double cullSum = 0.0;
+
+        for (size_t mi = 0; mi < meshlets.size(); ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            totalVerts += m.VertCount;
+            totalPrims += m.PrimCount;
+
+            if (mi < cullData.size())
+            {
+                // Primitives are culled when dot(view, axis) >= cutoff, which covers (1 - cutoff) / 2 of the view sphere
+                const float cutoff = float(cullData[mi].NormalCone.w) / 255.f;
+                cullSum += double(m.PrimCount) * double(1.f - cutoff) * 0.5;
+            }
+        }
+
+        stats.VertexDuplication = (distinct > 0) ? float(double(totalVerts) / double(distinct)) : 0.f;
+        stats.VertexFill = float(double(totalVerts) / double(meshlets.size() * maxVerts));
+        stats.PrimitiveFill = float(double(totalPrims) / double(meshlets.size() * maxPrims));
+        stats.ConeCullRate = (totalPrims > 0) ? float(cullSum / double(totalPrims)) : 0.f;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Default cost model for ranking candidate meshlet sizes (lower is better)
+    //---------------------------------------------------------------------------------
+    float DefaultMeshletCost(const MeshletStats& stats) noexcept
+    {
+        // Configurable weighted sum parameters
+        constexpr float c_wtDuplication = 1.0f;
+        constexpr float c_wtFill = 0.5f;
+        constexpr float c_wtCull = 1.0f;
+
+        // A meshlet closes when either limit is reached, so the fuller of the two measures the unused capacity
+        const float fill = std::max(stats.VertexFill, stats.PrimitiveFill);
+
+        return c_wtDuplication * (stats.VertexDuplication - 1.0f)
+            + c_wtFill * (1.0f - fill)
+            - c_wtCull * stats.ConeCullRate;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Working state for one candidate meshlet size
+    //---------------------------------------------------------------------------------
+    struct MeshletCandidate
+    {
+        std::vector<Meshlet>            meshlets;
+        std::vector<uint8_t>            uniqueVertexIB;
+        std::vector<MeshletTriangle>    primitiveIndices;
+        MeshletStats                    stats;
+        HRESULT                         hr;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Builds meshlets for one candidate size and measures the result
+    //---------------------------------------------------------------------------------
+    template <typename T>
+    HRESULT EvaluateMeshletCandidate(
+        _In_reads_(nFaces * 3) const T* indices,
+        size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions,
+        size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        size_t maxVerts,
+        size_t maxPrims,
+        MESHLET_FLAGS flags,
+        MeshletCandidate& result) noexcept
+    {
+        try
+        {
+            const std::pair<size_t, size_t> s = { 0, nFaces };
+            std::pair<size_t, size_t> subset;
+
+            HRESULT hr = ComputeMeshletsInternal<T>(
+                indices, nFaces,
+                positions, nVerts,
+                &s, 1u,
+                adjacency,
+                result.meshlets,
+                result.uniqueVertexIB, result.primitiveIndices,
+                &subset,
+                maxVerts, maxPrims);
+            if (FAILED(hr))
+                return hr;
+
+            std::vector<CullData> cullData;
+            if (!result.meshlets.empty() && !result.uniqueVertexIB.empty() && !result.primitiveIndices.empty())
+            {
+                cullData.resize(result.meshlets.size());
+
+                hr = ComputeCullDataInternal<T>(
+                    positions, nVerts,
+                    result.meshlets.data(), result.meshlets.size(),
+                    reinterpret_cast<const T*>(result.uniqueVertexIB.data()), result.uniqueVertexIB.size() / sizeof(T),
+                    result.primitiveIndices.data(), result.primitiveIndices.size(),
+                    cullData.data(), flags);
+                if (FAILED(hr))
+                    return hr;
+            }
+
+            ComputeMeshletStats<T>(result.meshlets, result.uniqueVertexIB, cullData, nVerts, maxVerts, maxPrims, result.stats);
+        }
+        catch (const std::bad_alloc&)
+        {
+            return E_OUTOFMEMORY;
+        }
+        catch (...)
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Evaluates a list of meshlet size limits in parallel and keeps the lowest cost result
+    //---------------------------------------------------------------------------------
+    template <typename T>
+    HRESULT ComputeMeshletsBestSizeInternal(
+        _In_reads_(nFaces * 3) const T* indices,
+        size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions,
+        size_t nVerts,
+        _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nCandidates) const std::pair<size_t, size_t>* candidates,
+        size_t nCandidates,
+        std::vector<Meshlet>& meshlets,
+        std::vector<uint8_t>& uniqueVertexIB,
+        std::vector<MeshletTriangle>& primitiveIndices,
+        _Out_opt_ MeshletStats* bestStats,
+        const std::function<float __cdecl(const MeshletStats& stats)>& costFunc,
+        MESHLET_FLAGS flags)
+    {
+        if (!indices || !positions)
+            return E_INVALIDARG;
+
+        if (nFaces == 0 || nVerts == 0)
+            return E_INVALIDARG;
+
+        static const std::pair<size_t, size_t> s_defaultCandidates[] =
+        {
+            { 64, 64 },
+            { 64, 126 },
+            { 128, 128 },
+            { 128, 256 },
+            { 256, 256 },
+        };
+
+        if (!candidates)
+        {
+            if (nCandidates > 0)
+                return E_INVALIDARG;
+
+            candidates = s_defaultCandidates;
+            nCandidates = std::size(s_defaultCandidates);
+        }
+
+        if (!nCandidates || nCandidates > INT32_MAX)
+            return E_INVALIDARG;
+
+        // Validate the meshlet vertex & primitive sizes
+        for (size_t i = 0; i < nCandidates; ++i)
+        {
+            const size_t maxVerts = candidates[i].first;
+            const size_t maxPrims = candidates[i].second;
+
+            if (maxVerts < MESHLET_MINIMUM_SIZE || maxVerts > MESHLET_MAXIMUM_SIZE)
+                return E_INVALIDARG;
+
+            if (maxPrims < MESHLET_MINIMUM_SIZE || maxPrims > MESHLET_MAXIMUM_SIZE)
+                return E_INVALIDARG;
+        }
+
+        // Auto-generate adjacency data if not provided, so it is shared by all candidates.
+        std::unique_ptr<uint32_t[]> generatedAdj;
+        if (!adjacency)
+        {
+            generatedAdj.reset(new (std::nothrow) uint32_t[nFaces * 3]);
+            if (!generatedAdj)
+                return E_OUTOFMEMORY;
+
+            HRESULT hr = GenerateAdjacencyAndPointReps(indices, nFaces, positions, nVerts, 0.0f, nullptr, generatedAdj.get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            adjacency = generatedAdj.get();
+        }
+
+        std::vector<MeshletCandidate> results;
+        results.resize(nCandidates);
+
+        const int count = static_cast<int>(nCandidates);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+        for (int i = 0; i < count; ++i)
+        {
+            auto& r = results[size_t(i)];
+            r.hr = EvaluateMeshletCandidate(
+                indices, nFaces,
+                positions, nVerts,
+                adjacency,
+                candidates[i].first, candidates[i].second,
+                flags,
+                r);
+        }
+
+        // Rank the candidates serially so the cost function need not be thread-safe
+        size_t best = 0;
+        float bestCost = FLT_MAX;
+        for (size_t i = 0; i < nCandidates; ++i)
+        {
+            if (FAILED(results[i].hr))
+                return results[i].hr;
+
+            const float cost = (costFunc) ? costFunc(results[i].stats) : DefaultMeshletCost(results[i].stats);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                best = i;
+            }
+        }
+
+        auto& r = results[best];
+
+        // Append the winning meshlets to the output buffers.
+        const size_t vertBase = uniqueVertexIB.size() / sizeof(T);
+        const size_t primBase = primitiveIndices.size();
+
+        for (auto& m : r.meshlets)
+        {
+            m.VertOffset += static_cast<uint32_t>(vertBase);
+            m.PrimOffset += static_cast<uint32_t>(primBase);
+        }
+
+        meshlets.insert(meshlets.end(), r.meshlets.cbegin(), r.meshlets.cend());
+        uniqueVertexIB.insert(uniqueVertexIB.end(), r.uniqueVertexIB.cbegin(), r.uniqueVertexIB.cend());
+        primitiveIndices.insert(primitiveIndices.end(), r.primitiveIndices.cbegin(), r.primitiveIndices.cend());
+
+        if (bestStats)
+        {
+            *bestStats = r.stats;
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Spreads a 10-bit value out to every third bit for Morton (Z-order) encoding
+    //---------------------------------------------------------------------------------
+    inline uint32_t ExpandBits(uint32_t v) noexcept
+    {
+        v = (v * 0x00010001u) & 0xFF0000FFu;
+        v = (v * 0x00000101u) & 0x0F00F00Fu;
+        v = (v * 0x00000011u) & 0xC30C30C3u;
+        v = (v * 0x00000005u) & 0x49249249u;
+        return v;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Unpacks a quantized normal cone axis the same way the shader does
+    //---------------------------------------------------------------------------------
+    inline XMVECTOR XM_CALLCONV UnpackConeAxis(const XMUBYTEN4& cone) noexcept
+    {
+        const XMVECTOR v = XMLoadUByteN4(&cone);
+        return XMVector3Normalize(XMVectorSetW(XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne), 0));
+    }
+
+    //---------------------------------------------------------------------------------
+    // Computes conservative culling data enclosing a group of meshlets
+    //---------------------------------------------------------------------------------
+    void ComputeGroupCullData(
+        _In_reads_(count) const CullData* members,
+        size_t count,
+        std::vector<XMFLOAT3>& scratch,
+        CullData& group)
+    {
+        assert(members != nullptr && count > 0);
+
+        scratch.resize(count * 2);
+        XMFLOAT3* centers = scratch.data();
+        XMFLOAT3* axes = scratch.data() + count;
+
+        // Bounding sphere containing all the member spheres
+        bool degenerate = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            centers[i] = members[i].BoundingSphere.Center;
+            XMStoreFloat3(&axes[i], UnpackConeAxis(members[i].NormalCone));
+
+            if (members[i].NormalCone.w == 255)
+            {
+                degenerate = true;
+            }
+        }
+
+        BoundingSphere::CreateFromPoints(group.BoundingSphere, count, centers, sizeof(XMFLOAT3));
+        const XMVECTOR center = XMLoadFloat3(&group.BoundingSphere.Center);
+
+        float radius = 0.f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float dist = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&centers[i]), center)));
+            radius = std::max(radius, dist + members[i].BoundingSphere.Radius);
+        }
+
+        group.BoundingSphere.Radius = radius;
+        group.ApexOffset = 0.f;
+
+        // Group cone axis is the normalized center of the bounding sphere of member axes
+        XMVECTOR axis = g_XMZero;
+        if (!degenerate)
+        {
+            BoundingSphere asphere;
+            BoundingSphere::CreateFromPoints(asphere, count, axes, sizeof(XMFLOAT3));
+
+            axis = XMVectorSetW(XMLoadFloat3(&asphere.Center), 0);
+            degenerate = XMVector3Less(XMVector3LengthSq(axis), XMVectorReplicate(1e-6f));
+        }
+
+        float maxAngle = 0.f;
+        if (!degenerate)
+        {
+            // Quantize the axis first so the spread accounts for what the shader will see
+            XMBYTEN4 snquant;
+            XMStoreByteN4(&snquant, XMVector3Normalize(axis));
+
+            group.NormalCone.x = uint8_t(int16_t(snquant.x) + 128);
+            group.NormalCone.y = uint8_t(int16_t(snquant.y) + 128);
+            group.NormalCone.z = uint8_t(int16_t(snquant.z) + 128);
+            axis = UnpackConeAxis(group.NormalCone);
+
+            // Widen the cone to contain every member cone; w stores sin(a) of each member spread
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float d = std::min(1.f, std::max(-1.f, XMVectorGetX(XMVector3Dot(axis, XMLoadFloat3(&axes[i])))));
+                const float spread = asinf(float(members[i].NormalCone.w) / 255.f);
+                maxAngle = std::max(maxAngle, acosf(d) + spread);
+            }
+
+            // Same cutoff as ComputeCullData for a cone which is too wide to be useful
+            degenerate = (cosf(maxAngle) < 0.1f);
+        }
+
+        if (degenerate)
+        {
+            XMStoreUByteN4(&group.NormalCone, XMVectorSet(0, 0, 0, 1)); // Degenerate cone
+            return;
+        }
+
+        // Move the apex back along the axis until it is behind every member apex: with all member
+        // normals n within the cone, dot(n, axis) >= cos(angle + spread), so an offset of
+        // |center - apex| / cos(angle + spread) keeps every member triangle in its negative half-space.
+        float maxt = 0.f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const XMVECTOR memberAxis = XMLoadFloat3(&axes[i]);
+            const XMVECTOR apex = XMVectorSubtract(XMLoadFloat3(&centers[i]), XMVectorScale(memberAxis, members[i].ApexOffset));
+
+            const float d = std::min(1.f, std::max(-1.f, XMVectorGetX(XMVector3Dot(axis, memberAxis))));
+            const float spread = asinf(float(members[i].NormalCone.w) / 255.f);
+            const float k = cosf(acosf(d) + spread);
+            assert(k > 0.f);
+
+            const float e = XMVectorGetX(XMVector3Length(XMVectorSubtract(center, apex)));
+            maxt = std::max(maxt, e / k);
+        }
+
+        group.ApexOffset = maxt;
+
+        // Quantize -cos(a + 90) = sin(a) rounding upward
+        const float cutoff = sinf(maxAngle);
+        group.NormalCone.w = static_cast<uint8_t>(std::min(255.f, ceilf(cutoff * 255.f)));
+    }
+
+    //---------------------------------------------------------------------------------
+    // Sorts meshlets along a Morton curve of their centers and emits per-group cull data
+    //---------------------------------------------------------------------------------
+    HRESULT ComputeMeshletGroupsImpl(
+        _Inout_updates_all_(nMeshlets) Meshlet* meshlets,
+        _Inout_updates_all_(nMeshlets) CullData* cullData,
+        size_t nMeshlets,
+        std::vector<CullData>& groupCullData,
+        _Out_writes_opt_(nMeshlets) uint32_t* meshletRemap,
+        size_t groupSize)
+    {
+        if (!meshlets || !cullData || !nMeshlets || !groupSize)
+            return E_INVALIDARG;
+
+        if (nMeshlets >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        // Determine the extents of the meshlet centers
+        XMVECTOR vmin = XMVectorReplicate(FLT_MAX);
+        XMVECTOR vmax = XMVectorReplicate(-FLT_MAX);
+        for (size_t i = 0; i < nMeshlets; ++i)
+        {
+            const XMVECTOR c = XMLoadFloat3(&cullData[i].BoundingSphere.Center);
+            vmin = XMVectorMin(vmin, c);
+            vmax = XMVectorMax(vmax, c);
+        }
+
+        XMFLOAT3 bmin, extent;
+        XMStoreFloat3(&bmin, vmin);
+        XMStoreFloat3(&extent, XMVectorSubtract(vmax, vmin));
+
+        const float scale = 1023.f / std::max(std::max(extent.x, extent.y), std::max(extent.z, FLT_EPSILON));
+
+        using intpair_t = std::pair<uint32_t, uint32_t>;
+
+        std::vector<intpair_t> list;
+        list.reserve(nMeshlets);
+        for (size_t i = 0; i < nMeshlets; ++i)
+        {
+            const XMFLOAT3& c = cullData[i].BoundingSphere.Center;
+
+            const auto x = static_cast<uint32_t>(std::min(1023.f, std::max(0.f, (c.x - bmin.x) * scale)));
+            const auto y = static_cast<uint32_t>(std::min(1023.f, std::max(0.f, (c.y - bmin.y) * scale)));
+            const auto z = static_cast<uint32_t>(std::min(1023.f, std::max(0.f, (c.z - bmin.z) * scale)));
+
+            const uint32_t code = ExpandBits(x) | (ExpandBits(y) << 1) | (ExpandBits(z) << 2);
+            list.emplace_back(intpair_t(code, static_cast<uint32_t>(i)));
+        }
+
+        std::stable_sort(list.begin(), list.end(), [](const intpair_t& a, const intpair_t& b) noexcept -> bool
+            {
+                return (a.first < b.first);
+            });
+
+        // Apply the new meshlet order
+        std::vector<Meshlet> tempMeshlets(meshlets, meshlets + nMeshlets);
+        std::vector<CullData> tempCull(cullData, cullData + nMeshlets);
+
+        for (size_t j = 0; j < nMeshlets; ++j)
+        {
+            const uint32_t src = list[j].second;
+            meshlets[j] = tempMeshlets[src];
+            cullData[j] = tempCull[src];
+
+            if (meshletRemap)
+            {
+                meshletRemap[j] = src;
+            }
+        }
+
+        // Compute the culling data for each group
+        const size_t nGroups = (nMeshlets + groupSize - 1) / groupSize;
+        const size_t groupBase = groupCullData.size();
+        groupCullData.resize(groupBase + nGroups);
+
+        std::vector<XMFLOAT3> scratch;
+        for (size_t g = 0; g < nGroups; ++g)
+        {
+            const size_t first = g * groupSize;
+            const size_t count = std::min(groupSize, nMeshlets - first);
+
+            ComputeGroupCullData(&cullData[first], count, scratch, groupCullData[groupBase + g]);
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Generates a vertex remap in order of first use by the meshlets, and updates the
+    // unique vertex indices so each meshlet references a mostly contiguous range.
+    //---------------------------------------------------------------------------------
+    template <typename T>
+    HRESULT OptimizeVerticesForMeshletsImpl(
+        _In_reads_(nMeshlets) const Meshlet* meshlets,
+        size_t nMeshlets,
+        _Inout_updates_all_(nVertIndices) T* uniqueVertexIndices,
+        size_t nVertIndices,
+        size_t nVerts,
+        _Out_writes_(nVerts) uint32_t* vertexRemap,
+        _Out_opt_ size_t* trailingUnused) noexcept
+    {
+        if (!meshlets || !nMeshlets || !uniqueVertexIndices || !nVertIndices || !nVerts || !vertexRemap)
+            return E_INVALIDARG;
+
+        if (nVerts >= T(-1))
+            return E_INVALIDARG;
+
+        if (nVertIndices >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        if (trailingUnused)
+        {
+            *trailingUnused = 0;
+        }
+
+        std::unique_ptr<uint32_t[]> tempRemap(new (std::nothrow) uint32_t[nVerts]);
+        if (!tempRemap)
+            return E_OUTOFMEMORY;
+
+        memset(tempRemap.get(), 0xff, sizeof(uint32_t) * nVerts);
+
+        // Validate the meshlet ranges before touching the index data
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            if ((uint64_t(m.VertOffset) + uint64_t(m.VertCount)) > nVertIndices)
+                return E_UNEXPECTED;
+
+            for (size_t i = 0; i < m.VertCount; ++i)
+            {
+                if (uniqueVertexIndices[m.VertOffset + i] >= nVerts)
+                    return E_UNEXPECTED;
+            }
+        }
+
+        // Assign new vertex locations in order of first use
+        uint32_t curvertex = 0;
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            for (size_t i = 0; i < m.VertCount; ++i)
+            {
+                const T vIndex = uniqueVertexIndices[m.VertOffset + i];
+
+                if (tempRemap[vIndex] == UNUSED32)
+                {
+                    tempRemap[vIndex] = curvertex;
+                    ++curvertex;
+                }
+            }
+        }
+
+        // Rewrite the unique vertex indices, taking care with meshlets that share ranges
+        std::unique_ptr<bool[]> rewritten(new (std::nothrow) bool[nVertIndices]);
+        if (!rewritten)
+            return E_OUTOFMEMORY;
+
+        memset(rewritten.get(), 0, sizeof(bool) * nVertIndices);
+
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            for (size_t i = 0; i < m.VertCount; ++i)
+            {
+                const size_t j = m.VertOffset + i;
+                if (rewritten[j])
+                    continue;
+
+                uniqueVertexIndices[j] = static_cast<T>(tempRemap[uniqueVertexIndices[j]]);
+                rewritten[j] = true;
+            }
+        }
+
+        // inverse lookup
+        memset(vertexRemap, 0xff, sizeof(uint32_t) * nVerts);
+
+        size_t unused = 0;
+
+        for (uint32_t j = 0; j < nVerts; ++j)
+        {
+            const uint32_t vertindex = tempRemap[j];
+            if (vertindex == UNUSED32)
+            {
+                ++unused;
+            }
+            else
+            {
+                if (vertindex >= nVerts)
+                    return E_UNEXPECTED;
+
+                vertexRemap[vertindex] = j;
+            }
+        }
+
+        if (trailingUnused)
+        {
+            *trailingUnused = unused;
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Checks that the meshlets' vertex and primitive ranges lie within the buffers without
+    // overlapping, and that each primitive only uses its own meshlet's vertices
+    //---------------------------------------------------------------------------------
+    HRESULT ValidateMeshletRanges(
+        _In_reads_(nMeshlets) const Meshlet* meshlets,
+        size_t nMeshlets,
+        size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices,
+        size_t nPrimIndices) noexcept
+    {
+        bool ascending = true;
+        uint64_t vertEnd = 0;
+        uint64_t primEnd = 0;
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            if ((uint64_t(m.VertOffset) + m.VertCount) > nVertIndices
+                || (uint64_t(m.PrimOffset) + m.PrimCount) > nPrimIndices)
+                return E_UNEXPECTED;
+
+            const MeshletTriangle* pdata = primitiveIndices + m.PrimOffset;
+            for (size_t i = 0; i < m.PrimCount; ++i)
+            {
+                if (pdata[i].i0 >= m.VertCount || pdata[i].i1 >= m.VertCount || pdata[i].i2 >= m.VertCount)
+                    return E_UNEXPECTED;
+            }
+
+            // Meshlets are normally laid out in order, which makes the overlap test trivial
+            if (m.VertCount)
+            {
+                ascending &= (m.VertOffset >= vertEnd);
+                vertEnd = uint64_t(m.VertOffset) + m.VertCount;
+            }
+
+            if (m.PrimCount)
+            {
+                ascending &= (m.PrimOffset >= primEnd);
+                primEnd = uint64_t(m.PrimOffset) + m.PrimCount;
+            }
+        }
+
+        if (ascending)
+            return S_OK;
+
+        // Otherwise sort the ranges by offset, packed with their end, and compare neighbors
+        std::unique_ptr<uint64_t[]> ranges(new (std::nothrow) uint64_t[nMeshlets]);
+        if (!ranges)
+            return E_OUTOFMEMORY;
+
+        for (size_t pass = 0; pass < 2; ++pass)
+        {
+            size_t count = 0;
+            for (size_t mi = 0; mi < nMeshlets; ++mi)
+            {
+                auto& m = meshlets[mi];
+                const uint32_t offset = (pass == 0) ? m.VertOffset : m.PrimOffset;
+                const uint32_t size = (pass == 0) ? m.VertCount : m.PrimCount;
+                if (size)
+                {
+                    ranges[count++] = (uint64_t(offset) << 32) | (uint64_t(offset) + size);
+                }
+            }
+
+            std::sort(ranges.get(), ranges.get() + count);
+
+            for (size_t j = 1; j < count; ++j)
+            {
+                if ((ranges[j] >> 32) < (ranges[j - 1] & UINT32_MAX))
+                    return E_UNEXPECTED;
+            }
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Reorders the primitives of each meshlet so consecutive triangles share vertices,
+    // then renumbers the local vertices in order of first use.
+    //---------------------------------------------------------------------------------
+    template <typename T>
+    HRESULT OptimizeMeshletPrimitivesImpl(
+        _In_reads_(nMeshlets) const Meshlet* meshlets,
+        size_t nMeshlets,
+        _Inout_updates_all_(nVertIndices) T* uniqueVertexIndices,
+        size_t nVertIndices,
+        _Inout_updates_all_(nPrimIndices) MeshletTriangle* primitiveIndices,
+        size_t nPrimIndices) noexcept
+    {
+        if (!meshlets || !nMeshlets || !uniqueVertexIndices || !nVertIndices || !primitiveIndices || !nPrimIndices)
+            return E_INVALIDARG;
+
+        if (nVertIndices >= UINT32_MAX || nPrimIndices >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        constexpr uint16_t c_Unused = uint16_t(-1);
+
+        uint16_t tris[MESHLET_MAXIMUM_SIZE][3] = {};
+        uint16_t valence[MESHLET_MAXIMUM_SIZE] = {};
+        uint16_t triOffsets[MESHLET_MAXIMUM_SIZE + 1] = {};
+        uint16_t triList[MESHLET_MAXIMUM_SIZE * 3] = {};
+        uint16_t order[MESHLET_MAXIMUM_SIZE] = {};
+        uint16_t newIndex[MESHLET_MAXIMUM_SIZE] = {};
+        bool emitted[MESHLET_MAXIMUM_SIZE] = {};
+        T verts[MESHLET_MAXIMUM_SIZE] = {};
+
+        // Validate every meshlet before any are rewritten in place
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            if (meshlets[mi].VertCount > MESHLET_MAXIMUM_SIZE || meshlets[mi].PrimCount > MESHLET_MAXIMUM_SIZE)
+                return E_UNEXPECTED;
+        }
+
+        HRESULT hr = ValidateMeshletRanges(meshlets, nMeshlets, nVertIndices, primitiveIndices, nPrimIndices);
+        if (FAILED(hr))
+            return hr;
+
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            const size_t vertCount = m.VertCount;
+            const size_t primCount = m.PrimCount;
+            if (!primCount)
+                continue;
+
+            // Build the local vertex to triangle lists
+            memset(valence, 0, sizeof(valence));
+            for (size_t i = 0; i < primCount; ++i)
+            {
+                const auto& prim = primitiveIndices[m.PrimOffset + i];
+
+                tris[i][0] = static_cast<uint16_t>(prim.i0);
+                tris[i][1] = static_cast<uint16_t>(prim.i1);
+                tris[i][2] = static_cast<uint16_t>(prim.i2);
+
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    ++valence[tris[i][k]];
+                }
+
+                emitted[i] = false;
+            }
+
+            triOffsets[0] = 0;
+            for (size_t v = 0; v < vertCount; ++v)
+            {
+                triOffsets[v + 1] = static_cast<uint16_t>(triOffsets[v] + valence[v]);
+                newIndex[v] = triOffsets[v];
+            }
+
+            for (size_t i = 0; i < primCount; ++i)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    triList[newIndex[tris[i][k]]++] = static_cast<uint16_t>(i);
+                }
+            }
+
+            // Start from the triangle with the lowest total valence, which is usually on a boundary
+            uint16_t current = 0;
+            {
+                uint32_t best = UINT32_MAX;
+                for (size_t i = 0; i < primCount; ++i)
+                {
+                    const uint32_t total = uint32_t(valence[tris[i][0]]) + valence[tris[i][1]] + valence[tris[i][2]];
+                    if (total < best)
+                    {
+                        best = total;
+                        current = static_cast<uint16_t>(i);
+                    }
+                }
+            }
+
+            size_t scanStart = 0;
+            for (size_t count = 0; count < primCount; ++count)
+            {
+                order[count] = current;
+                emitted[current] = true;
+
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    --valence[tris[current][k]];
+                }
+
+                if (count + 1 >= primCount)
+                    break;
+
+                // Prefer a neighbor sharing an edge with the last triangle, then one which retires
+                // the most live vertices. Walk back through recent triangles on a dead end.
+                uint16_t next = c_Unused;
+                for (size_t back = 0; back <= count && back < 8 && next == c_Unused; ++back)
+                {
+                    const uint16_t* last = tris[order[count - back]];
+
+                    int bestScore = INT32_MIN;
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const uint16_t v = last[k];
+                        for (size_t j = triOffsets[v]; j < triOffsets[v + 1]; ++j)
+                        {
+                            const uint16_t t = triList[j];
+                            if (emitted[t])
+                                continue;
+
+                            int shared = 0;
+                            int live = 0;
+                            for (size_t n = 0; n < 3; ++n)
+                            {
+                                const uint16_t tv = tris[t][n];
+                                if (tv == last[0] || tv == last[1] || tv == last[2])
+                                    ++shared;
+                                live += valence[tv];
+                            }
+
+                            const int score = shared * 1024 - live;
+                            if (score > bestScore)
+                            {
+                                bestScore = score;
+                                next = t;
+                            }
+                        }
+                    }
+                }
+
+                if (next == c_Unused)
+                {
+                    while (scanStart < primCount && emitted[scanStart])
+                        ++scanStart;
+
+                    assert(scanStart < primCount);
+                    next = static_cast<uint16_t>(scanStart);
+                }
+
+                current = next;
+            }
+
+            // Renumber local vertices in order of first use
+            memset(newIndex, 0xff, sizeof(newIndex));
+
+            uint16_t nextIndex = 0;
+            for (size_t i = 0; i < primCount; ++i)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint16_t v = tris[order[i]][k];
+                    if (newIndex[v] == c_Unused)
+                    {
+                        newIndex[v] = nextIndex++;
+                    }
+                }
+            }
+
+            for (size_t v = 0; v < vertCount; ++v)
+            {
+                if (newIndex[v] == c_Unused)
+                {
+                    newIndex[v] = nextIndex++;
+                }
+            }
+
+            T* vdata = uniqueVertexIndices + m.VertOffset;
+            memcpy(verts, vdata, sizeof(T) * vertCount);
+            for (size_t v = 0; v < vertCount; ++v)
+            {
+                vdata[newIndex[v]] = verts[v];
+            }
+
+            // Write out the primitives, rotated so the lowest index comes first to preserve winding
+            MeshletTriangle* pdata = primitiveIndices + m.PrimOffset;
+            for (size_t i = 0; i < primCount; ++i)
+            {
+                uint32_t a = newIndex[tris[order[i]][0]];
+                uint32_t b = newIndex[tris[order[i]][1]];
+                uint32_t c = newIndex[tris[order[i]][2]];
+
+                if (b < a && b < c)
+                {
+                    const uint32_t t = a; a = b; b = c; c = t;
+                }
+                else if (c < a && c < b)
+                {
+                    const uint32_t t = c; c = b; b = a; a = t;
+                }
+
+                pdata[i].i0 = a;
+                pdata[i].i1 = b;
+                pdata[i].i2 = c;
+            }
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Expands meshlets back into a triangle list in meshlet order
+    //---------------------------------------------------------------------------------
+    template<class T>
+    HRESULT GenerateMeshletIBImpl(
+        _In_reads_(nMeshlets) const Meshlet* meshlets,
+        size_t nMeshlets,
+        _In_reads_(nVertIndices) const T* uniqueVertexIndices,
+        size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices,
+        size_t nPrimIndices,
+        _Out_writes_(nPrimIndices * 3) T* indices,
+        _Out_writes_opt_(nMeshlets) std::pair<size_t, size_t>* drawRanges) noexcept
+    {
+        if (!meshlets || !uniqueVertexIndices || !primitiveIndices || !indices)
+            return E_INVALIDARG;
+
+        if (nMeshlets == 0 || nVertIndices == 0 || nPrimIndices == 0)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nPrimIndices) * 3) >= UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        // Validate every meshlet up front so a failure leaves the output untouched
+        HRESULT hr = ValidateMeshletRanges(meshlets, nMeshlets, nVertIndices, primitiveIndices, nPrimIndices);
+        if (FAILED(hr))
+            return hr;
+
+        // The ranges don't overlap, so every primitive is referenced by exactly one meshlet when the counts add up
+        uint64_t total = 0;
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            total += meshlets[mi].PrimCount;
+        }
+
+        if (total != nPrimIndices)
+            return E_UNEXPECTED;
+
+        size_t offset = 0;
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            auto& m = meshlets[mi];
+
+            const T* vdata = uniqueVertexIndices + m.VertOffset;
+            const MeshletTriangle* pdata = primitiveIndices + m.PrimOffset;
+            T* dest = indices + offset * 3;
+
+            for (size_t i = 0; i < m.PrimCount; ++i)
+            {
+                const MeshletTriangle& tri = pdata[i];
+                dest[i * 3] = vdata[tri.i0];
+                dest[i * 3 + 1] = vdata[tri.i1];
+                dest[i * 3 + 2] = vdata[tri.i2];
+            }
+
+            if (drawRanges)
+            {
+                drawRanges[mi] = std::pair<size_t, size_t>(offset * 3, size_t(m.PrimCount) * 3);
+            }
+
+            offset += m.PrimCount;
+        }
+
+        return S_OK;
+    }
 }
 
 
@@ -842,6 +1829,58 @@ HRESULT DirectX::ComputeMeshlets(
         maxVerts, maxPrims);
 }
 
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshletsBestSize(
+    const uint16_t* indices,
+    size_t nFaces,
+    const XMFLOAT3* positions,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    const std::pair<size_t, size_t>* candidates,
+    size_t nCandidates,
+    std::vector<Meshlet>& meshlets,
+    std::vector<uint8_t>& uniqueVertexIB,
+    std::vector<MeshletTriangle>& primitiveIndices,
+    MeshletStats* bestStats,
+    std::function<float __cdecl(const MeshletStats& stats)> costFunc,
+    MESHLET_FLAGS flags)
+{
+    return ComputeMeshletsBestSizeInternal<uint16_t>(
+        indices, nFaces,
+        positions, nVerts,
+        adjacency,
+        candidates, nCandidates,
+        meshlets,
+        uniqueVertexIB, primitiveIndices,
+        bestStats, costFunc, flags);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshletsBestSize(
+    const uint32_t* indices,
+    size_t nFaces,
+    const XMFLOAT3* positions,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    const std::pair<size_t, size_t>* candidates,
+    size_t nCandidates,
+    std::vector<Meshlet>& meshlets,
+    std::vector<uint8_t>& uniqueVertexIB,
+    std::vector<MeshletTriangle>& primitiveIndices,
+    MeshletStats* bestStats,
+    std::function<float __cdecl(const MeshletStats& stats)> costFunc,
+    MESHLET_FLAGS flags)
+{
+    return ComputeMeshletsBestSizeInternal<uint32_t>(
+        indices, nFaces,
+        positions, nVerts,
+        adjacency,
+        candidates, nCandidates,
+        meshlets,
+        uniqueVertexIB, primitiveIndices,
+        bestStats, costFunc, flags);
+}
+
 _Use_decl_annotations_
 HRESULT DirectX::ComputeCullData(
     const XMFLOAT3* positions,
@@ -884,3 +1923,117 @@ HRESULT DirectX::ComputeCullData(
         cullData,
         flags);
 }
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshletGroups(
+    Meshlet* meshlets,
+    CullData* cullData,
+    size_t nMeshlets,
+    std::vector<CullData>& groupCullData,
+    uint32_t* meshletRemap,
+    size_t groupSize)
+{
+    return ComputeMeshletGroupsImpl(
+        meshlets, cullData, nMeshlets,
+        groupCullData,
+        meshletRemap,
+        groupSize);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeVerticesForMeshlets(
+    const Meshlet* meshlets,
+    size_t nMeshlets,
+    uint16_t* uniqueVertexIndices,
+    size_t nVertIndices,
+    size_t nVerts,
+    uint32_t* vertexRemap,
+    size_t* trailingUnused) noexcept
+{
+    return OptimizeVerticesForMeshletsImpl<uint16_t>(
+        meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices,
+        nVerts, vertexRemap, trailingUnused);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeVerticesForMeshlets(
+    const Meshlet* meshlets,
+    size_t nMeshlets,
+    uint32_t* uniqueVertexIndices,
+    size_t nVertIndices,
+    size_t nVerts,
+    uint32_t* vertexRemap,
+    size_t* trailingUnused) noexcept
+{
+    return OptimizeVerticesForMeshletsImpl<uint32_t>(
+        meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices,
+        nVerts, vertexRemap, trailingUnused);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeMeshletPrimitives(
+    const Meshlet* meshlets,
+    size_t nMeshlets,
+    uint16_t* uniqueVertexIndices,
+    size_t nVertIndices,
+    MeshletTriangle* primitiveIndices,
+    size_t nPrimIndices) noexcept
+{
+    return OptimizeMeshletPrimitivesImpl<uint16_t>(
+        meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices,
+        primitiveIndices, nPrimIndices);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeMeshletPrimitives(
+    const Meshlet* meshlets,
+    size_t nMeshlets,
+    uint32_t* uniqueVertexIndices,
+    size_t nVertIndices,
+    MeshletTriangle* primitiveIndices,
+    size_t nPrimIndices) noexcept
+{
+    return OptimizeMeshletPrimitivesImpl<uint32_t>(
+        meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices,
+        primitiveIndices, nPrimIndices);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateMeshletIB(
+    const Meshlet* meshlets,
+    size_t nMeshlets,
+    const uint16_t* uniqueVertexIndices,
+    size_t nVertIndices,
+    const MeshletTriangle* primitiveIndices,
+    size_t nPrimIndices,
+    uint16_t* indices,
+    std::pair<size_t, size_t>* drawRanges) noexcept
+{
+    return GenerateMeshletIBImpl<uint16_t>(
+        meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices,
+        primitiveIndices, nPrimIndices,
+        indices, drawRanges);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateMeshletIB(
+    const Meshlet* meshlets,
+    size_t nMeshlets,
+    const uint32_t* uniqueVertexIndices,
+    size_t nVertIndices,
+    const MeshletTriangle* primitiveIndices,
+    size_t nPrimIndices,
+    uint32_t* indices,
+    std::pair<size_t, size_t>* drawRanges) noexcept
+{
+    return GenerateMeshletIBImpl<uint32_t>(
+        meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices,
+        primitiveIndices, nPrimIndices,
+        indices, drawRanges);
+}
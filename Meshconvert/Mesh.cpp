@@ -414,16 +414,12 @@ HRESULT Mesh::Clean() noexcept
     if (!pos)
         return E_OUTOFMEMORY;
 
-    memcpy(pos.get(), mPositions.get(), sizeof(XMFLOAT3) * mnVerts);
-
     std::unique_ptr<XMFLOAT3[]> norms;
     if (mNormals)
     {
         norms.reset(new (std::nothrow) XMFLOAT3[nNewVerts]);
         if (!norms)
             return E_OUTOFMEMORY;
-
-        memcpy(norms.get(), mNormals.get(), sizeof(XMFLOAT3) * mnVerts);
     }
 
     std::unique_ptr<XMFLOAT4[]> tans1;
@@ -432,8 +428,6 @@ HRESULT Mesh::Clean() noexcept
         tans1.reset(new (std::nothrow) XMFLOAT4[nNewVerts]);
         if (!tans1)
             return E_OUTOFMEMORY;
-
-        memcpy(tans1.get(), mTangents.get(), sizeof(XMFLOAT4) * mnVerts);
     }
 
     std::unique_ptr<XMFLOAT3[]> tans2;
@@ -442,8 +436,6 @@ HRESULT Mesh::Clean() noexcept
         tans2.reset(new (std::nothrow) XMFLOAT3[nNewVerts]);
         if (!tans2)
             return E_OUTOFMEMORY;
-
-        memcpy(tans2.get(), mBiTangents.get(), sizeof(XMFLOAT3) * mnVerts);
     }
 
     std::unique_ptr<XMFLOAT2[]> texcoord;
@@ -452,8 +444,6 @@ HRESULT Mesh::Clean() noexcept
         texcoord.reset(new (std::nothrow) XMFLOAT2[nNewVerts]);
         if (!texcoord)
             return E_OUTOFMEMORY;
-
-        memcpy(texcoord.get(), mTexCoords.get(), sizeof(XMFLOAT2) * mnVerts);
     }
 
     std::unique_ptr<XMFLOAT4[]> colors;
@@ -462,8 +452,6 @@ HRESULT Mesh::Clean() noexcept
         colors.reset(new (std::nothrow) XMFLOAT4[nNewVerts]);
         if (!colors)
             return E_OUTOFMEMORY;
-
-        memcpy(colors.get(), mColors.get(), sizeof(XMFLOAT4) * mnVerts);
     }
 
     std::unique_ptr<XMFLOAT4[]> blendIndices;
@@ -472,8 +460,6 @@ HRESULT Mesh::Clean() noexcept
         blendIndices.reset(new (std::nothrow) XMFLOAT4[nNewVerts]);
         if (!blendIndices)
             return E_OUTOFMEMORY;
-
-        memcpy(blendIndices.get(), mBlendIndices.get(), sizeof(XMFLOAT4) * mnVerts);
     }
 
     std::unique_ptr<XMFLOAT4[]> blendWeights;
@@ -482,52 +468,37 @@ HRESULT Mesh::Clean() noexcept
         blendWeights.reset(new (std::nothrow) XMFLOAT4[nNewVerts]);
         if (!blendWeights)
             return E_OUTOFMEMORY;
-
-        memcpy(blendWeights.get(), mBlendWeights.get(), sizeof(XMFLOAT4) * mnVerts);
     }
 
-    size_t j = mnVerts;
-    for (auto it = dups.begin(); it != dups.end() && (j < nNewVerts); ++it, ++j)
-    {
-        assert(*it < mnVerts);
-
-        pos[j] = mPositions[*it];
-
-        if (norms)
-        {
-            norms[j] = mNormals[*it];
-        }
-
-        if (tans1)
-        {
-            tans1[j] = mTangents[*it];
-        }
-
-        if (tans2)
-        {
-            tans2[j] = mBiTangents[*it];
-        }
-
-        if (texcoord)
-        {
-            texcoord[j] = mTexCoords[*it];
-        }
-
-        if (colors)
-        {
-            colors[j] = mColors[*it];
-        }
-
-        if (blendIndices)
-        {
-            blendIndices[j] = mBlendIndices[*it];
-        }
+    // Copy the original vertices and the duplicates for every stream in one pass
+    const void* vbin[8] = {};
+    void* vbout[8] = {};
+    size_t strides[8] = {};
+    size_t nStreams = 0;
 
-        if (blendWeights)
+    auto addStream = [&](const void* src, void* dest, size_t stride) noexcept
         {
-            blendWeights[j] = mBlendWeights[*it];
-        }
-    }
+            if (src && dest)
+            {
+                vbin[nStreams] = src;
+                vbout[nStreams] = dest;
+                strides[nStreams] = stride;
+                ++nStreams;
+            }
+        };
+
+    addStream(mPositions.get(), pos.get(), sizeof(XMFLOAT3));
+    addStream(mNormals.get(), norms.get(), sizeof(XMFLOAT3));
+    addStream(mTangents.get(), tans1.get(), sizeof(XMFLOAT4));
+    addStream(mBiTangents.get(), tans2.get(), sizeof(XMFLOAT3));
+    addStream(mTexCoords.get(), texcoord.get(), sizeof(XMFLOAT2));
+    addStream(mColors.get(), colors.get(), sizeof(XMFLOAT4));
+    addStream(mBlendIndices.get(), blendIndices.get(), sizeof(XMFLOAT4));
+    addStream(mBlendWeights.get(), blendWeights.get(), sizeof(XMFLOAT4));
+
+    hr = FinalizeVB(vbin, strides, nStreams, mnVerts, dups.data(), dups.size(), nullptr, vbout);
+    if (FAILED(hr))
+        return hr;
 
     mPositions.swap(pos);
     mNormals.swap(norms);
@@ -697,60 +668,95 @@ HRESULT Mesh::Optimize(bool lru) noexcept
     if (FAILED(hr))
         return hr;
 
-    hr = FinalizeVB(mPositions.get(), sizeof(XMFLOAT3), mnVerts, remap.get());
+    void* vbs[8] = {};
+    size_t strides[8] = {};
+    size_t nStreams = 0;
+
+    auto addStream = [&](void* vb, size_t stride) noexcept
+        {
+            if (vb)
+            {
+                vbs[nStreams] = vb;
+                strides[nStreams] = stride;
+                ++nStreams;
+            }
+        };
+
+    addStream(mPositions.get(), sizeof(XMFLOAT3));
+    addStream(mNormals.get(), sizeof(XMFLOAT3));
+    addStream(mTangents.get(), sizeof(XMFLOAT4));
+    addStream(mBiTangents.get(), sizeof(XMFLOAT3));
+    addStream(mTexCoords.get(), sizeof(XMFLOAT2));
+    addStream(mColors.get(), sizeof(XMFLOAT4));
+    addStream(mBlendIndices.get(), sizeof(XMFLOAT4));
+    addStream(mBlendWeights.get(), sizeof(XMFLOAT4));
+
+    hr = FinalizeVB(vbs, strides, nStreams, mnVerts, remap.get());
     if (FAILED(hr))
         return hr;
 
-    if (mNormals)
-    {
-        hr = FinalizeVB(mNormals.get(), sizeof(XMFLOAT3), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
-    }
+    return S_OK;
+}
 
-    if (mTangents)
-    {
-        hr = FinalizeVB(mTangents.get(), sizeof(XMFLOAT4), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
-    }
 
-    if (mBiTangents)
-    {
-        hr = FinalizeVB(mBiTangents.get(), sizeof(XMFLOAT3), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
-    }
+//--------------------------------------------------------------------------------------
+HRESULT Mesh::GenerateShadowMesh(std::unique_ptr<Mesh>& result) const noexcept
+{
+    result.reset();
 
-    if (mTexCoords)
-    {
-        hr = FinalizeVB(mTexCoords.get(), sizeof(XMFLOAT2), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
-    }
+    if (!mnFaces || !mIndices || !mnVerts || !mPositions)
+        return E_UNEXPECTED;
 
-    if (mColors)
-    {
-        hr = FinalizeVB(mColors.get(), sizeof(XMFLOAT4), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
-    }
+    if ((uint64_t(mnFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-    if (mBlendIndices)
-    {
-        hr = FinalizeVB(mBlendIndices.get(), sizeof(XMFLOAT4), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
+    // Vertices split by Clean or by normal/texcoord seams are welded back together by position
+    std::unique_ptr<uint32_t[]> pointRep(new (std::nothrow) uint32_t[mnVerts]);
+    std::unique_ptr<uint32_t[]> remap(new (std::nothrow) uint32_t[mnVerts]);
+    std::unique_ptr<uint32_t[]> indices(new (std::nothrow) uint32_t[mnFaces * 3]);
+    if (!pointRep || !remap || !indices)
+        return E_OUTOFMEMORY;
 
-    }
+    HRESULT hr = GenerateAdjacencyAndPointReps(mIndices.get(), mnFaces, mPositions.get(), mnVerts, 0.f, pointRep.get(), nullptr);
+    if (FAILED(hr))
+        return hr;
 
-    if (mBlendWeights)
+    size_t trailingUnused = 0;
+    hr = GenerateShadowIB(mIndices.get(), mnFaces, mnVerts, pointRep.get(), mAttributes.get(), indices.get(), remap.get(), &trailingUnused);
+    if (FAILED(hr))
+        return hr;
+
+    const size_t nVerts = mnVerts - trailingUnused;
+
+    std::unique_ptr<XMFLOAT3[]> pos(new (std::nothrow) XMFLOAT3[nVerts]);
+    if (!pos)
+        return E_OUTOFMEMORY;
+
+    hr = CompactVB(mPositions.get(), sizeof(XMFLOAT3), mnVerts, trailingUnused, remap.get(), pos.get());
+    if (FAILED(hr))
+        return hr;
+
+    // Faces are only reordered within each attribute group, so the attributes still apply
+    std::unique_ptr<uint32_t[]> attributes;
+    if (mAttributes)
     {
-        hr = FinalizeVB(mBlendWeights.get(), sizeof(XMFLOAT4), mnVerts, remap.get());
-        if (FAILED(hr))
-            return hr;
+        attributes.reset(new (std::nothrow) uint32_t[mnFaces]);
+        if (!attributes)
+            return E_OUTOFMEMORY;
+
+        memcpy(attributes.get(), mAttributes.get(), sizeof(uint32_t) * mnFaces);
     }
 
+    result.reset(new (std::nothrow) Mesh);
+    if (!result)
+        return E_OUTOFMEMORY;
+
+    result->mPositions.swap(pos);
+    result->mIndices.swap(indices);
+    result->mAttributes.swap(attributes);
+    result->mnVerts = nVerts;
+    result->mnFaces = mnFaces;
+
     return S_OK;
 }
 
@@ -1082,6 +1088,74 @@ HRESULT Mesh::ExportToVBO(const wchar_t* szFileName) const noexcept
 }
 
 
+//--------------------------------------------------------------------------------------
+// Index buffer sidecar file: header followed by the DirectXMesh EncodeIB stream
+//--------------------------------------------------------------------------------------
+namespace
+{
+    constexpr uint32_t IBC_MAGIC = 0x31434249; // "IBC1"
+
+#pragma pack(push,1)
+    struct ibc_header_t
+    {
+        uint32_t magic;
+        uint32_t numIndices;
+        uint32_t indexSize;     // Width of the index buffer in the matching mesh file (2 or 4)
+        uint32_t encodedSize;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(ibc_header_t) == 16, "IBC header size mismatch");
+}
+
+_Use_decl_annotations_
+HRESULT Mesh::ExportToIBC(const wchar_t* szFileName, bool force32bit) const
+{
+    if (!szFileName)
+        return E_INVALIDARG;
+
+    if (!mnFaces || !mIndices)
+        return E_UNEXPECTED;
+
+    if ((uint64_t(mnFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    std::vector<uint8_t> encoded;
+    HRESULT hr = EncodeIB(mIndices.get(), mnFaces, encoded);
+    if (FAILED(hr))
+        return hr;
+
+    if (encoded.size() >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    ibc_header_t header;
+    header.magic = IBC_MAGIC;
+    header.numIndices = static_cast<uint32_t>(mnFaces * 3);
+    header.indexSize = (!force32bit && Is16BitIndexBuffer()) ? 2u : 4u;
+    header.encodedSize = static_cast<uint32_t>(encoded.size());
+
+    ScopedHandle hFile(safe_handle(CreateFile2(
+        szFileName,
+        GENERIC_WRITE, 0, CREATE_ALWAYS,
+        nullptr)));
+    if (!hFile)
+        return HRESULT_FROM_WIN32(GetLastError());
+
+    hr = write_file(hFile.get(), header);
+    if (FAILED(hr))
+        return hr;
+
+    DWORD bytesWritten;
+    if (!WriteFile(hFile.get(), encoded.data(), header.encodedSize, &bytesWritten, nullptr))
+        return HRESULT_FROM_WIN32(GetLastError());
+
+    if (bytesWritten != header.encodedSize)
+        return E_FAIL;
+
+    return S_OK;
+}
+
+
 //--------------------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT Mesh::CreateFromVBO(const wchar_t* szFileName, std::unique_ptr<Mesh>& result) noexcept
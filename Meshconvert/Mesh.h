@@ -57,6 +57,8 @@ public:
 
     HRESULT Optimize(bool lru) noexcept;
 
+    HRESULT GenerateShadowMesh(_Inout_ std::unique_ptr<Mesh>& result) const noexcept;
+
     HRESULT ReverseWinding() noexcept;
 
     HRESULT InvertUTexCoord() noexcept;
@@ -134,6 +136,7 @@ public:
 
     HRESULT ExportToOBJ(const wchar_t* szFileName, _In_ size_t nMaterials, _In_reads_opt_(nMaterials) const Material* materials) const;
     HRESULT ExportToVBO(_In_z_ const wchar_t* szFileName) const noexcept;
+    HRESULT ExportToIBC(_In_z_ const wchar_t* szFileName, bool force32bit = false) const;
     HRESULT ExportToCMO(_In_z_ const wchar_t* szFileName, _In_ size_t nMaterials, _In_reads_opt_(nMaterials) const Material* materials) const noexcept;
     HRESULT ExportToSDKMESH(_In_z_ const wchar_t* szFileName,
         _In_ size_t nMaterials, _In_reads_opt_(nMaterials) const Material* materials,
@@ -85,6 +85,8 @@ namespace
         OPT_FLIPV,
         OPT_FLIPZ,
         OPT_NOLOGO,
+        OPT_SHADOW_MESH,
+        OPT_INDEX_COMPRESS,
         OPT_FLAGS_MAX,
         OPT_FILETYPE,
         OPT_OUTPUTFILE,
@@ -133,6 +135,8 @@ namespace
         { L"fc",        OPT_VERT_COLOR_FORMAT },
         { L"nologo",    OPT_NOLOGO },
         { L"flist",     OPT_FILELIST },
+        { L"shadow",    OPT_SHADOW_MESH },
+        { L"ibc",       OPT_INDEX_COMPRESS },
 
         // Legacy selection switches for file type (use -ft instead)
         { L"sdkmesh",   OPT_SDKMESH },
@@ -162,6 +166,7 @@ namespace
         { L"geometric-adjacency",       OPT_GEOMETRIC_ADJ },
         { L"help",                      OPT_HELP },
         { L"index-buffer-32-bit",       OPT_FORCE_32BIT_IB },
+        { L"index-buffer-compress",     OPT_INDEX_COMPRESS },
         { L"normal-format",             OPT_VERT_NORMAL_FORMAT },
         { L"normals-by-angle",          OPT_NORMALS },
         { L"normals-by-area",           OPT_WEIGHT_BY_AREA },
@@ -169,6 +174,7 @@ namespace
         { L"optimize-lru",              OPT_OPTIMIZE_LRU },
         { L"optimize",                  OPT_OPTIMIZE },
         { L"overwrite",                 OPT_OVERWRITE },
+        { L"shadow-mesh",               OPT_SHADOW_MESH },
         { L"tangent-frame",             OPT_CTF },
         { L"tangents",                  OPT_TANGENTS },
         { L"to-lowercase",              OPT_TOLOWER },
@@ -269,6 +275,8 @@ namespace
             L"   -op, --optimize   -oplru, --optimize-lru\n"
             L"                                  vertex cache optimize the mesh (implies -c)\n"
             L"   -c, --clean                    mesh cleaning including vertex dups for attribute sets\n"
+            L"   -shadow, --shadow-mesh         also write a position-only <name>_shadow mesh for depth passes\n"
+            L"   -ibc, --index-buffer-compress  also write a compressed index buffer <name>.ibc (sdkmesh/vbo only)\n"
             L"   -ta, --topological-adjacency -or- -ga, --geometric-adjacency\n"
             L"                                  generate topological vs. geometric adjacency (def: ta)\n"
             L"\n"
@@ -945,6 +953,55 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             }
         }
 
+        std::wstring ibcFile;
+        if (dwOptions & (UINT32_C(1) << OPT_INDEX_COMPRESS))
+        {
+            if (_wcsicmp(outputExt, L".sdkmesh") != 0 && _wcsicmp(outputExt, L".vbo") != 0)
+            {
+                wprintf(L"\nERROR: Compressed index buffer requires sdkmesh or vbo output\n");
+                return 1;
+            }
+
+            std::filesystem::path ibcPath(outputFile);
+            ibcPath.replace_extension(L".ibc");
+            ibcFile = ibcPath.native();
+
+            if (~dwOptions & (UINT32_C(1) << OPT_OVERWRITE))
+            {
+                if (GetFileAttributesW(ibcFile.c_str()) != INVALID_FILE_ATTRIBUTES)
+                {
+                    wprintf(L"\nERROR: Output file already exists, use -y to overwrite:\n'%ls'\n", ibcFile.c_str());
+                    return 1;
+                }
+            }
+        }
+
+        std::wstring shadowFile;
+        if (dwOptions & (UINT32_C(1) << OPT_SHADOW_MESH))
+        {
+            if (_wcsicmp(outputExt, L".sdkmesh") != 0 && _wcsicmp(outputExt, L".obj") != 0 && _wcsicmp(outputExt, L"._obj") != 0)
+            {
+                wprintf(L"\nERROR: Shadow mesh requires sdkmesh or obj output\n");
+                return 1;
+            }
+
+            std::filesystem::path shadowPath(outputFile);
+            std::wstring shadowName = shadowPath.stem().native();
+            shadowName.append(L"_shadow");
+            shadowName.append(outputExt);
+            shadowPath.replace_filename(shadowName);
+            shadowFile = shadowPath.native();
+
+            if (~dwOptions & (UINT32_C(1) << OPT_OVERWRITE))
+            {
+                if (GetFileAttributesW(shadowFile.c_str()) != INVALID_FILE_ATTRIBUTES)
+                {
+                    wprintf(L"\nERROR: Output file already exists, use -y to overwrite:\n'%ls'\n", shadowFile.c_str());
+                    return 1;
+                }
+            }
+        }
+
         if (!_wcsicmp(outputExt, L".vbo"))
         {
             if (!inMesh->GetNormalBuffer() || !inMesh->GetTexCoordBuffer())
@@ -1011,6 +1068,58 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
         }
 
         wprintf(L" %zu vertices, %zu faces written:\n'%ls'\n", nVerts, nFaces, outputFile.c_str());
+
+        // Write compressed index buffer sidecar for streaming
+        if (!ibcFile.empty())
+        {
+            // VBO output is always 16-bit, so only sdkmesh honors -ib32
+            const bool ibc32 = (dwOptions & (UINT32_C(1) << OPT_FORCE_32BIT_IB)) && !_wcsicmp(outputExt, L".sdkmesh");
+
+            hr = inMesh->ExportToIBC(ibcFile.c_str(), ibc32);
+            if (FAILED(hr))
+            {
+                wprintf(L"\nERROR: Failed write (%08X%ls):-> '%ls'\n",
+                    static_cast<unsigned int>(hr), GetErrorDesc(hr), ibcFile.c_str());
+                return 1;
+            }
+
+            wprintf(L" %zu faces compressed:\n'%ls'\n", nFaces, ibcFile.c_str());
+        }
+
+        // Write position-only mesh for depth and shadow passes
+        if (!shadowFile.empty())
+        {
+            std::unique_ptr<Mesh> shadowMesh;
+            hr = inMesh->GenerateShadowMesh(shadowMesh);
+            if (FAILED(hr))
+            {
+                wprintf(L"\nERROR: Failed generating shadow mesh (%08X%ls)\n",
+                    static_cast<unsigned int>(hr), GetErrorDesc(hr));
+                return 1;
+            }
+
+            if (!_wcsicmp(outputExt, L".sdkmesh"))
+            {
+                hr = shadowMesh->ExportToSDKMESH(
+                    shadowFile.c_str(),
+                    inMaterial.size(), inMaterial.empty() ? nullptr : inMaterial.data(),
+                    (dwOptions & (UINT32_C(1) << OPT_FORCE_32BIT_IB)) ? true : false,
+                    (fileType == CODEC_SDKMESH_V2) ? true : false);
+            }
+            else
+            {
+                hr = shadowMesh->ExportToOBJ(shadowFile.c_str(), inMaterial.size(), inMaterial.empty() ? nullptr : inMaterial.data());
+            }
+
+            if (FAILED(hr))
+            {
+                wprintf(L"\nERROR: Failed write (%08X%ls):-> '%ls'\n",
+                    static_cast<unsigned int>(hr), GetErrorDesc(hr), shadowFile.c_str());
+                return 1;
+            }
+
+            wprintf(L" %zu vertices, %zu faces written:\n'%ls'\n", shadowMesh->GetVertexCount(), shadowMesh->GetFaceCount(), shadowFile.c_str());
+        }
     }
 
     return 0;